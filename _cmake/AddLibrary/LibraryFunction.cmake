@@ -110,6 +110,27 @@ function(MAKE_LIBRARY LIB_NAME)
 		add_custom_command(TARGET "${executable_name}" POST_BUILD COMMAND "${CMAKE_CURRENT_BINARY_DIR}/${CMAKE_CFG_INTDIR}/${executable_name}")
 	endif()
 
+	# build a benchmark executable, these are not run as part of the build.
+	if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/tests/benchmark/")
+		set(benchmark_name "${library_name}-Bench")
+		message("Adding Benchmark Executable '${benchmark_name}'")
+
+		add_source("${CMAKE_CURRENT_SOURCE_DIR}/tests/benchmark/" install_bench_headers bench_headers bench_implementation)
+		add_executable(${benchmark_name} ${bench_headers} ${bench_implementation})
+
+		add_dependencies(
+			${benchmark_name}
+			${library_name}
+		)
+
+		target_link_libraries(
+			 ${benchmark_name}
+			 ${library_name}
+			 ${dependencies}
+			 ${platform_dependencies}
+		)
+	endif()
+
 	# the tests/acceptance_test/ directory is expected to
 	# contain folders (1 for each acceptance test executable)
 	# containing a CMakeLists.txt file. 
@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace arbiter {
+
+    // The accepted sub-intervals of a range of sequence numbers (e.g. a packet),
+    // in order, kept in a fixed capacity buffer so range validation doesn't allocate.
+    // A range split into more than Capacity intervals has the excess merged into
+    // the last interval and truncated() set, the last interval then also spans
+    // sequence numbers that were rejected.
+    template<typename SequenceType, std::size_t Capacity = 8>
+    class AcceptedIntervals
+    {
+    public:
+        static_assert(Capacity > 0, "AcceptedIntervals requires a Capacity of at least one.");
+
+        // the @count sequence numbers [first, first + count).
+        struct Interval
+        {
+            SequenceType first;
+            std::size_t count;
+        };
+
+        AcceptedIntervals() { clear(); }
+
+        // append @count accepted sequence numbers starting at @first, extending
+        // the last interval when @first follows on from it.
+        inline void append(const SequenceType first, const std::size_t count);
+        inline void clear();
+
+        std::size_t size() const { return size_; }
+        static constexpr std::size_t capacity() { return Capacity; }
+
+        bool empty() const { return size_ == 0; }
+        bool truncated() const { return truncated_; }
+
+        // sequence numbers accepted, over every interval.
+        std::size_t accepted() const { return accepted_; }
+
+        const Interval& operator[](const std::size_t i) const { return intervals_[i]; }
+
+        const Interval* begin() const { return intervals_.data(); }
+        const Interval* end() const { return intervals_.data() + size_; }
+
+    private:
+        std::array<Interval, Capacity> intervals_;
+        std::size_t size_;
+        std::size_t accepted_;
+        bool truncated_;
+    };
+
+
+    template<typename SequenceType, std::size_t Capacity>
+    void AcceptedIntervals<SequenceType, Capacity>::append(const SequenceType first, const std::size_t count)
+    {
+        accepted_ += count;
+
+        if(size_ != 0)
+        {
+            auto& last = intervals_[size_ - 1];
+            const auto follows = static_cast<SequenceType>(first - last.first);
+
+            if(static_cast<std::size_t>(follows) == last.count)
+            {
+                last.count += count;
+                return;
+            }
+
+            if(size_ == Capacity)
+            {
+                last.count = static_cast<std::size_t>(follows) + count;
+                truncated_ = true;
+                return;
+            }
+        }
+
+        intervals_[size_++] = Interval{first, count};
+    }
+
+    template<typename SequenceType, std::size_t Capacity>
+    void AcceptedIntervals<SequenceType, Capacity>::clear()
+    {
+        size_ = 0;
+        accepted_ = 0;
+        truncated_ = false;
+    }
+}
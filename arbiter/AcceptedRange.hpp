@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+namespace arbiter {
+
+    // The part of a range of sequence numbers (e.g. a packet) to pass on.
+    // [first, first + count) spans every accepted sequence number, accepted
+    // is how many of them were accepted. accepted is less than count only
+    // when another line already filled sequence numbers inside the span.
+    template<typename SequenceType>
+    struct AcceptedRange
+    {
+        SequenceType first;
+        std::size_t count;
+        std::size_t accepted;
+
+        bool empty() const { return accepted == 0; }
+        bool contiguous() const { return accepted == count; }
+    };
+}
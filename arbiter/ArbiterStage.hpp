@@ -0,0 +1,138 @@
+#pragma once
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/SequenceArithmetic.hpp>
+#include <arbiter/details/SpscRing.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace arbiter {
+
+    // A pipeline stage feeding one SequenceArbiter from a thread per line.
+    // Each line's thread push()es (sequence number, @Handle) pairs into its
+    // own lock-free single producer / single consumer ring, one consumer
+    // thread drain()s the rings into validate() and hands the handles of
+    // accepted messages downstream. Handles are copied, never the payload
+    // they refer to (e.g. a pointer or index into a receive buffer pool).
+    //
+    // drain() always takes the message with the lowest sequence number at
+    // the front of any ring (in serial number order with
+    // Traits::SerialNumberArithmetic()), so skew between the line threads doesn't turn
+    // into out of order delivery. The arbiter then sees far fewer of the
+    // HeadForwardGapFill / LineForwardGapFill transitions caused purely by
+    // scheduling, and less needless Gap / GapFill reporting.
+    template<class Traits, class Handle>
+    class ArbiterStage
+    {
+    public:
+        using SequenceType = typename Traits::SequenceType;
+        using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
+
+        struct Entry
+        {
+            SequenceType sequenceNumber;
+            Handle handle;
+        };
+
+        // one ring of @ringCapacity (a power of two) entries per line.
+        ArbiterStage(ErrorReportingPolicy& errorPolicy, const std::size_t ringCapacity);
+
+        ArbiterStage(const ArbiterStage&) = delete;
+        ArbiterStage& operator=(const ArbiterStage&) = delete;
+
+        // producer, called only from @line's thread. False when @line's ring is full.
+        inline bool push(const std::size_t line, const SequenceType sequenceNumber, const Handle& handle);
+
+        // consumer, validate up to @maxMessages queued messages lowest sequence number first.
+        // @accepted(line, sequenceNumber, handle) is called for messages to pass downstream,
+        // @rejected(line, sequenceNumber, handle) for the rest (e.g. to recycle their buffers).
+        // Returns the number of messages drained, 0 when every ring is empty.
+        template<class Accepted, class Rejected>
+        std::size_t drain(Accepted&& accepted, Rejected&& rejected, const std::size_t maxMessages = std::numeric_limits<std::size_t>::max());
+
+        SequenceArbiter<Traits>& arbiter() { return arbiter_; }   // consumer thread only
+
+    private:
+        using Ring = details::SpscRing<Entry>;
+        using Sequence = details::SequenceArithmetic<Traits>;
+
+        // the line whose ring front has the lowest sequence number, NumberOfLines() when all are empty.
+        inline std::size_t lowestLine(const Entry*& entry);
+
+    private:
+        SequenceArbiter<Traits> arbiter_;
+        std::vector<std::unique_ptr<Ring>> rings_;
+    };
+
+
+    template<class Traits, class Handle>
+    ArbiterStage<Traits, Handle>::ArbiterStage(ErrorReportingPolicy& errorPolicy, const std::size_t ringCapacity)
+        : arbiter_(errorPolicy)
+    {
+        rings_.reserve(Traits::NumberOfLines());
+        for(std::size_t line = 0; line < Traits::NumberOfLines(); ++line)
+        {
+            rings_.emplace_back(new Ring(ringCapacity));
+        }
+    }
+
+    template<class Traits, class Handle>
+    bool ArbiterStage<Traits, Handle>::push(const std::size_t line, const SequenceType sequenceNumber, const Handle& handle)
+    {
+        return rings_[line]->tryPush(Entry{sequenceNumber, handle});
+    }
+
+    template<class Traits, class Handle>
+    template<class Accepted, class Rejected>
+    std::size_t ArbiterStage<Traits, Handle>::drain(Accepted&& accepted, Rejected&& rejected, const std::size_t maxMessages)
+    {
+        std::size_t drained = 0;
+
+        while(drained < maxMessages)
+        {
+            const Entry* entry = nullptr;
+            const auto line = lowestLine(entry);
+            if(line == Traits::NumberOfLines())
+            {
+                break;
+            }
+
+            // copy out before pop() hands the slot back to the producer.
+            const Entry message = *entry;
+            rings_[line]->pop();
+
+            if(arbiter_.validate(line, message.sequenceNumber))
+            {
+                accepted(line, message.sequenceNumber, message.handle);
+            }
+            else
+            {
+                rejected(line, message.sequenceNumber, message.handle);
+            }
+
+            ++drained;
+        }
+
+        return drained;
+    }
+
+    template<class Traits, class Handle>
+    std::size_t ArbiterStage<Traits, Handle>::lowestLine(const Entry*& entry)
+    {
+        std::size_t lowest = Traits::NumberOfLines();
+
+        for(std::size_t line = 0; line < Traits::NumberOfLines(); ++line)
+        {
+            const auto front = rings_[line]->front();
+            if((front != nullptr) && ((entry == nullptr) || Sequence::precedes(front->sequenceNumber, entry->sequenceNumber)))
+            {
+                entry = front;
+                lowest = line;
+            }
+        }
+
+        return lowest;
+    }
+}
@@ -0,0 +1,335 @@
+#pragma once
+#include <arbiter/details/AlignedBuffer.hpp>
+#include <arbiter/details/BitOperations.hpp>
+#include <arbiter/details/BranchHints.hpp>
+#include <arbiter/details/SequenceArithmetic.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace arbiter {
+
+    // A sequence arbiter which each line's thread may call concurrently,
+    // without a lock and without funnelling the lines through one thread.
+    // Every history slot is a single atomic word packing the sequence number
+    // it holds (tag) with the mask of lines which delivered it. A line claims
+    // a sequence number by moving its slot's tag forward with a CAS, and
+    // records a copy by setting its bit under the same tag, so exactly one
+    // call per sequence number across all lines returns true. Head is
+    // advanced with a CAS too, the thread advancing it past missing sequence
+    // numbers reports the Gap. As in SequenceArbiter, only the
+    // Traits::LargestRecoverableGap() sequence numbers before the new head stay
+    // recoverable, the rest of a longer gap is reported as an UnrecoverableGap
+    // and late copies of them are discarded (a copy racing the jump may still
+    // be accepted). A sequence number missing from a recoverable gap is reported
+    // unrecoverable once its slot is reused, HistoryDepth() sequence numbers on.
+    //
+    // The ErrorReportingPolicy is called from the line threads and must be
+    // thread-safe. Reported are FirstSequenceNumberOutOfSequence,
+    // DuplicateOnLine, Gap, GapFill and UnrecoverableGap (a sequence number
+    // which left the history without being accepted).
+    //
+    // Slots and head hold sequence numbers counted from
+    // FirstExpectedSequenceNumber(), which run on across a wrap of
+    // SequenceType. With Traits::SerialNumberArithmetic() an incoming sequence
+    // number is placed relative to head, so the feed may wrap; each call then
+    // loads head once more. The count since reset() must fit in
+    // 64 - NumberOfLines bits.
+    template<class Traits>
+    class ConcurrentSequenceArbiter
+    {
+    public:
+        using SequenceType = typename Traits::SequenceType;
+        using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
+
+        explicit ConcurrentSequenceArbiter(ErrorReportingPolicy& errorPolicy);
+
+        ConcurrentSequenceArbiter(const ConcurrentSequenceArbiter&) = delete;
+        ConcurrentSequenceArbiter& operator=(const ConcurrentSequenceArbiter&) = delete;
+
+        // Determine whether we should accept @sequenceNumber received on @line,
+        // safe to call from a thread per line.
+        inline bool validate(const std::size_t line, const SequenceType sequenceNumber);
+
+        // Return the arbiter to its initial state, no line may be validating.
+        void reset();
+
+        ErrorReportingPolicy& errorPolicy() { return errorPolicy_; }
+
+    private:
+        static constexpr std::size_t LineBits = Traits::NumberOfLines();
+        static constexpr std::uint64_t LineMask = (std::uint64_t(1) << LineBits) - 1;
+
+        static_assert(LineBits > 0 && LineBits <= 16, "ConcurrentSequenceArbiter supports 1 to 16 lines.");
+        static_assert(Traits::HistoryDepth() > 0, "HistoryDepth() must be positive.");
+
+        using Slot = std::atomic<std::uint64_t>;
+        using Sequence = details::SequenceArithmetic<Traits>;
+
+        // tags are the count from the first expected sequence number + 1, tag 0 marks a slot never claimed.
+        static std::uint64_t tagOf(const std::uint64_t sequence) { return sequence + 1; }
+        static std::uint64_t pack(const std::uint64_t tag, const std::uint64_t lines) { return (tag << LineBits) | lines; }
+
+        // the sequence number counted @sequence on from the first expected one.
+        static SequenceType sequenceNumberOf(const std::uint64_t sequence) { return static_cast<SequenceType>(static_cast<std::uint64_t>(Traits::FirstExpectedSequenceNumber()) + sequence); }
+
+        // count @sequenceNumber from the first expected sequence number, false if it precedes it.
+        inline bool count(const SequenceType sequenceNumber, std::uint64_t& sequence) const;
+        inline bool count(const SequenceType sequenceNumber, std::uint64_t& sequence, std::false_type /*serial*/) const;
+        inline bool count(const SequenceType sequenceNumber, std::uint64_t& sequence, std::true_type /*serial*/) const;
+
+        inline std::size_t position(const std::uint64_t sequence) const;
+
+        // the sequence numbers [first, end) a forward jump reported unrecoverable, empty if none.
+        struct Unrecoverable
+        {
+            std::uint64_t first;
+            std::uint64_t end;
+
+            bool contains(const std::uint64_t sequence) const { return (sequence >= first) && (sequence < end); }
+        };
+
+        // the slot held the sequence with tag @previousTag before @sequenceNumber claimed it, report
+        // the sequence numbers in between which shared the slot and were never claimed, other than @reported.
+        inline void recycled(const std::uint64_t sequenceNumber, const std::uint64_t previousTag, const Unrecoverable& reported);
+
+        // move head up to @sequence, reporting gaps and gap fills.
+        inline Unrecoverable advanceHead(const std::uint64_t sequence);
+
+        // report the gap from @head to @sequence, head's new value is @sequence + 1.
+        Unrecoverable reportGap(const std::uint64_t head, const std::uint64_t sequence);
+
+        // claim the slots of @unrecoverable's sequence numbers, and the slots left holding one of them
+        // before the jump to @sequence, for no line. Late copies then find them taken and a slot's
+        // reuse doesn't report them again.
+        void markUnrecoverable(const Unrecoverable& unrecoverable, const std::uint64_t sequence);
+
+    private:
+        ErrorReportingPolicy& errorPolicy_;
+        std::unique_ptr<Slot[]> history_;
+        char padding0_[details::AlignedBuffer::CacheLineSize];
+
+        // the next expected sequence number (counted), on its own cache line as every accept touches it.
+        std::atomic<std::uint64_t> head_;
+        char padding1_[details::AlignedBuffer::CacheLineSize];
+    };
+
+
+    template<class Traits>
+    constexpr std::size_t ConcurrentSequenceArbiter<Traits>::LineBits;
+
+    template<class Traits>
+    constexpr std::uint64_t ConcurrentSequenceArbiter<Traits>::LineMask;
+
+    template<class Traits>
+    ConcurrentSequenceArbiter<Traits>::ConcurrentSequenceArbiter(ErrorReportingPolicy& errorPolicy)
+        : errorPolicy_(errorPolicy)
+        , history_(new Slot[Traits::HistoryDepth()])
+    {
+        reset();
+    }
+
+    template<class Traits>
+    bool ConcurrentSequenceArbiter<Traits>::validate(const std::size_t line, const SequenceType sequenceNumber)
+    {
+        std::uint64_t sequence = 0;
+        if(ARBITER_UNLIKELY(!count(sequenceNumber, sequence)))
+        {
+            errorPolicy_.FirstSequenceNumberOutOfSequence(line, sequenceNumber);
+            return false;
+        }
+
+        const auto tag = tagOf(sequence);
+        const auto bit = std::uint64_t(1) << line;
+
+        auto& slot = history_[position(sequence)];
+        auto value = slot.load(std::memory_order_acquire);
+
+        for(;;)
+        {
+            const auto slotTag = value >> LineBits;
+
+            if(slotTag > tag)
+            {
+                return false;   // the slot has moved on, @sequenceNumber left the history
+            }
+
+            if(slotTag == tag)
+            {
+                if((value & bit) != 0)
+                {
+                    errorPolicy_.DuplicateOnLine(line, sequenceNumber);
+                    return false;
+                }
+
+                // the expected copy from another line. The OR is a CAS on the whole
+                // word, so it can't land on a newer sequence recycling the slot.
+                if(slot.compare_exchange_weak(value, value | bit, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    return false;
+                }
+
+                continue;
+            }
+
+            // an older sequence number, claim the slot.
+            if(slot.compare_exchange_weak(value, pack(tag, bit), std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                // head first, a forward jump reports the sequence number this slot held if it's in the unrecoverable part.
+                const auto unrecoverable = advanceHead(sequence);
+                recycled(sequence, slotTag, unrecoverable);
+
+                return true;
+            }
+        }
+    }
+
+    template<class Traits>
+    void ConcurrentSequenceArbiter<Traits>::reset()
+    {
+        for(std::size_t i = 0; i < Traits::HistoryDepth(); ++i)
+        {
+            history_[i].store(0, std::memory_order_relaxed);
+        }
+
+        head_.store(0, std::memory_order_release);
+    }
+
+    template<class Traits>
+    bool ConcurrentSequenceArbiter<Traits>::count(const SequenceType sequenceNumber, std::uint64_t& sequence) const
+    {
+        return count(sequenceNumber, sequence, std::integral_constant<bool, Sequence::Serial>());
+    }
+
+    template<class Traits>
+    bool ConcurrentSequenceArbiter<Traits>::count(const SequenceType sequenceNumber, std::uint64_t& sequence, std::false_type) const
+    {
+        sequence = static_cast<std::uint64_t>(sequenceNumber) - static_cast<std::uint64_t>(Traits::FirstExpectedSequenceNumber());
+        return !(sequenceNumber < Traits::FirstExpectedSequenceNumber());
+    }
+
+    template<class Traits>
+    bool ConcurrentSequenceArbiter<Traits>::count(const SequenceType sequenceNumber, std::uint64_t& sequence, std::true_type) const
+    {
+        // head may move on meanwhile, @sequenceNumber stays within half the SequenceType range of it.
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto headSequenceNumber = sequenceNumberOf(head);
+
+        if(Sequence::precedesOrEqual(headSequenceNumber, sequenceNumber))
+        {
+            sequence = head + static_cast<std::uint64_t>(Sequence::distance(headSequenceNumber, sequenceNumber));
+            return true;
+        }
+
+        const auto behind = static_cast<std::uint64_t>(Sequence::distance(sequenceNumber, headSequenceNumber));
+        sequence = head - behind;
+        return behind <= head;
+    }
+
+    template<class Traits>
+    std::size_t ConcurrentSequenceArbiter<Traits>::position(const std::uint64_t sequence) const
+    {
+        return details::isPowerOfTwo(Traits::HistoryDepth())
+            ? static_cast<std::size_t>(sequence & (Traits::HistoryDepth() - 1))
+            : static_cast<std::size_t>(sequence % Traits::HistoryDepth());
+    }
+
+    template<class Traits>
+    void ConcurrentSequenceArbiter<Traits>::recycled(const std::uint64_t sequenceNumber, const std::uint64_t previousTag, const Unrecoverable& reported)
+    {
+        const std::uint64_t depth = Traits::HistoryDepth();
+
+        // the lap after the one claimed last, or the first lap for a slot never claimed.
+        auto lapped = previousTag != 0 ? previousTag - 1 + depth : sequenceNumber % depth;
+
+        while(lapped < sequenceNumber)
+        {
+            if(reported.contains(lapped))
+            {
+                lapped += ((reported.end - lapped + depth - 1) / depth) * depth;
+                continue;
+            }
+
+            errorPolicy_.UnrecoverableGap(sequenceNumberOf(lapped));
+            lapped += depth;
+        }
+    }
+
+    template<class Traits>
+    typename ConcurrentSequenceArbiter<Traits>::Unrecoverable ConcurrentSequenceArbiter<Traits>::advanceHead(const std::uint64_t sequence)
+    {
+        auto head = head_.load(std::memory_order_acquire);
+
+        while(head <= sequence)
+        {
+            if(head_.compare_exchange_weak(head, sequence + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return reportGap(head, sequence);
+            }
+        }
+
+        // head was already past @sequence, a message missing until now.
+        errorPolicy_.GapFill(sequenceNumberOf(sequence), 1);
+        return Unrecoverable{0, 0};
+    }
+
+    template<class Traits>
+    typename ConcurrentSequenceArbiter<Traits>::Unrecoverable ConcurrentSequenceArbiter<Traits>::reportGap(const std::uint64_t head, const std::uint64_t sequence)
+    {
+        const auto gapSize = sequence - head;
+        if(gapSize == 0)
+        {
+            return Unrecoverable{0, 0};
+        }
+
+        if(gapSize <= Traits::LargestRecoverableGap())
+        {
+            errorPolicy_.Gap(sequenceNumberOf(head), static_cast<SequenceType>(gapSize));
+            return Unrecoverable{0, 0};
+        }
+
+        const Unrecoverable unrecoverable{head, sequence - Traits::LargestRecoverableGap()};
+
+        errorPolicy_.UnrecoverableGap(sequenceNumberOf(head), static_cast<SequenceType>(unrecoverable.end - head));
+        errorPolicy_.Gap(sequenceNumberOf(unrecoverable.end), static_cast<SequenceType>(Traits::LargestRecoverableGap()));
+
+        markUnrecoverable(unrecoverable, sequence);
+        return unrecoverable;
+    }
+
+    template<class Traits>
+    void ConcurrentSequenceArbiter<Traits>::markUnrecoverable(const Unrecoverable& unrecoverable, const std::uint64_t sequence)
+    {
+        const std::uint64_t depth = Traits::HistoryDepth();
+        const auto back = [depth](const std::uint64_t from) { return from > depth ? from - depth : 0; };
+
+        const auto mark = [this, &unrecoverable](const std::uint64_t first, const std::uint64_t end)
+        {
+            for(auto marked = first; marked < end; ++marked)
+            {
+                auto& slot = history_[position(marked)];
+                auto value = slot.load(std::memory_order_acquire);
+
+                while((value >> LineBits) < tagOf(marked))
+                {
+                    if(slot.compare_exchange_weak(value, pack(tagOf(marked), 0), std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        recycled(marked, value >> LineBits, unrecoverable);
+                        break;
+                    }
+                }
+            }
+        };
+
+        // the unrecoverable sequence numbers in the history's last lap up to @sequence, then for each slot of
+        // the recoverable gap in that lap the unrecoverable sequence number it held. @sequence's own slot was
+        // claimed by the caller, together at most HistoryDepth() - 1 slots.
+        const auto lastLap = back(sequence + 1);
+
+        mark(std::max(unrecoverable.first, lastLap), unrecoverable.end);
+        mark(std::max(unrecoverable.first, back(std::max(unrecoverable.end, lastLap))), back(sequence));
+    }
+}
@@ -10,4 +10,41 @@ namespace arbiter {
     public:
         ArbiterCacheAdvancerStateEnumOutOfRange(const std::size_t value);
     };
+
+    class UnknownStream : public std::out_of_range
+    {
+    public:
+        UnknownStream(const std::size_t streamId);
+    };
+
+    class DuplicateStream : public std::invalid_argument
+    {
+    public:
+        DuplicateStream(const std::size_t streamId);
+    };
+
+    class StreamCapacityExceeded : public std::length_error
+    {
+    public:
+        StreamCapacityExceeded(const std::size_t capacity);
+    };
+
+    class InvalidHistoryConfig : public std::invalid_argument
+    {
+    public:
+        InvalidHistoryConfig(const std::size_t numberOfLines, const std::size_t historyDepth, const std::size_t maxNumberOfLines);
+        InvalidHistoryConfig(const char* reason);
+    };
+
+    class InvalidRingCapacity : public std::invalid_argument
+    {
+    public:
+        InvalidRingCapacity(const std::size_t capacity);
+    };
+
+    class InvalidSnapshot : public std::invalid_argument
+    {
+    public:
+        InvalidSnapshot(const char* reason);
+    };
 }
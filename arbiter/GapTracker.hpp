@@ -0,0 +1,317 @@
+#pragma once
+#include <arbiter/RetransmissionConfig.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace arbiter {
+
+    // An ErrorReportingPolicy which keeps the gaps the arbiter still has open, in
+    // step with its Gap(), GapFill() and UnrecoverableGap() callbacks, and turns
+    // them into coalesced, rate limited retransmission requests. Open gaps are
+    // kept oldest first as ranges, in storage reserved for @capacity ranges, more
+    // allocate. capacity() gives one which holds every gap of an arbiter's history.
+    // A gap is closed when filled or when the arbiter overwrites or drops
+    // its slots, both reported through UnrecoverableGap(). Every callback is passed on
+    // to @Base, e.g. GapTracker<std::uint64_t, StatsErrorReportingPolicy<std::uint64_t, 2>>.
+    // Call clear() along with the arbiter's reset(). Use from the arbiter's thread.
+    template<typename SequenceType, class Base = details::NullErrorReportingPolicy<SequenceType>>
+    class GapTracker : public Base
+    {
+    public:
+        // the @length sequence numbers [first, first + length).
+        struct Range
+        {
+            SequenceType first;
+            std::size_t length;
+        };
+
+        GapTracker(const std::size_t capacity, const RetransmissionConfig& config);
+
+        // the most ranges open at once behind an arbiter with a history of @historyDepth slots
+        // (its most when it may grow): gaps are at least one delivered sequence number apart,
+        // and requestRetransmissions() splits them into adjacent ranges of config.maxRangeLength.
+        static std::size_t capacity(const std::size_t historyDepth, const RetransmissionConfig& config);
+
+        void Gap(const SequenceType start, const SequenceType length);
+        void GapFill(const SequenceType start, const SequenceType length);
+        void UnrecoverableGap(const SequenceType start, const SequenceType length = 1);
+
+        // call @function(range) for each open gap, oldest first.
+        template<class Function>
+        void forEachGap(Function&& function) const;
+
+        std::vector<Range> outstandingGaps() const;
+
+        std::size_t gaps() const { return gaps_.size(); }
+        std::size_t missing() const { return missing_; }     // sequence numbers in open gaps
+
+        // call @request(first, length) for each range due a retransmission request at @now, oldest
+        // first. A gap is due once open for config.delay, and again every config.retryInterval
+        // while it stays open. Due gaps at most config.mergeDistance apart are requested as one
+        // range, up to config.maxRangeLength long. Returns the requests made, at most config.maxRequests.
+        template<class Request>
+        std::size_t requestRetransmissions(const std::uint64_t now, Request&& request);
+
+        void clear();
+
+    private:
+        using Offset = typename std::make_unsigned<SequenceType>::type;
+
+        static constexpr std::uint64_t Never = std::numeric_limits<std::uint64_t>::max();
+
+        struct OpenGap
+        {
+            SequenceType first;
+            std::size_t length;
+            std::uint64_t opened;       // first seen by requestRetransmissions(), Never until then
+            std::uint64_t requested;    // last requested, Never until then
+        };
+
+        // how far @to is ahead of @from, ordering sequence numbers across a wrap.
+        static std::size_t distance(const SequenceType from, const SequenceType to) { return static_cast<Offset>(static_cast<Offset>(to) - static_cast<Offset>(from)); }
+        static SequenceType advance(const SequenceType sequence, const std::size_t count) { return static_cast<SequenceType>(static_cast<Offset>(sequence) + count); }
+
+        // remove [@start, @start + @length) from the open gaps.
+        void close(const SequenceType start, const std::size_t length);
+
+        bool due(OpenGap& gap, const std::uint64_t now) const;
+
+    private:
+        std::vector<OpenGap> gaps_;
+        const RetransmissionConfig config_;
+
+        std::size_t missing_;
+    };
+
+
+    template<typename SequenceType, class Base>
+    constexpr std::uint64_t GapTracker<SequenceType, Base>::Never;
+
+    template<typename SequenceType, class Base>
+    GapTracker<SequenceType, Base>::GapTracker(const std::size_t capacity, const RetransmissionConfig& config)
+        : config_(config)
+        , missing_(0)
+    {
+        gaps_.reserve(capacity);
+    }
+
+    template<typename SequenceType, class Base>
+    std::size_t GapTracker<SequenceType, Base>::capacity(const std::size_t historyDepth, const RetransmissionConfig& config)
+    {
+        // within a run of adjacent ranges all but the last are a full request long.
+        const std::size_t longest = config.maxRangeLength != 0 ? config.maxRangeLength : 1;
+        return historyDepth / 2 + 1 + historyDepth / longest;
+    }
+
+    template<typename SequenceType, class Base>
+    void GapTracker<SequenceType, Base>::Gap(const SequenceType start, const SequenceType length)
+    {
+        Base::Gap(start, length);
+
+        if(length == 0)
+        {
+            return;
+        }
+
+        if(!gaps_.empty())
+        {
+            // behind (or within) the newest open gap, the arbiter was reset.
+            const auto& newest = gaps_.back();
+            const auto ahead = distance(newest.first, start);
+
+            if((ahead < newest.length) || (ahead > std::numeric_limits<Offset>::max() / 2))
+            {
+                clear();
+            }
+        }
+
+        gaps_.push_back(OpenGap{start, static_cast<std::size_t>(length), Never, Never});
+        missing_ += static_cast<std::size_t>(length);
+    }
+
+    template<typename SequenceType, class Base>
+    void GapTracker<SequenceType, Base>::GapFill(const SequenceType start, const SequenceType length)
+    {
+        Base::GapFill(start, length);
+        close(start, static_cast<std::size_t>(length));
+    }
+
+    template<typename SequenceType, class Base>
+    void GapTracker<SequenceType, Base>::UnrecoverableGap(const SequenceType start, const SequenceType length)
+    {
+        Base::UnrecoverableGap(start, length);
+        close(start, static_cast<std::size_t>(length));
+    }
+
+    template<typename SequenceType, class Base>
+    template<class Function>
+    void GapTracker<SequenceType, Base>::forEachGap(Function&& function) const
+    {
+        for(const auto& gap : gaps_)
+        {
+            function(Range{gap.first, gap.length});
+        }
+    }
+
+    template<typename SequenceType, class Base>
+    std::vector<typename GapTracker<SequenceType, Base>::Range> GapTracker<SequenceType, Base>::outstandingGaps() const
+    {
+        std::vector<Range> ranges;
+        ranges.reserve(gaps_.size());
+
+        forEachGap([&ranges](const Range& range) { ranges.push_back(range); });
+        return ranges;
+    }
+
+    template<typename SequenceType, class Base>
+    template<class Request>
+    std::size_t GapTracker<SequenceType, Base>::requestRetransmissions(const std::uint64_t now, Request&& request)
+    {
+        const std::size_t longest = config_.maxRangeLength != 0 ? config_.maxRangeLength : 1;
+
+        std::size_t requests = 0;
+        std::size_t i = 0;
+
+        while((i < gaps_.size()) && (requests < config_.maxRequests))
+        {
+            if(!due(gaps_[i], now))
+            {
+                ++i;
+                continue;
+            }
+
+            // a gap longer than a request is requested in parts.
+            if(gaps_[i].length > longest)
+            {
+                auto tail = gaps_[i];
+                tail.first = advance(tail.first, longest);
+                tail.length -= longest;
+
+                gaps_[i].length = longest;
+                gaps_.insert(gaps_.begin() + static_cast<std::ptrdiff_t>(i) + 1, tail);
+            }
+
+            const auto first = gaps_[i].first;
+            std::size_t length = gaps_[i].length;
+
+            gaps_[i++].requested = now;
+
+            // merge the due gaps which follow closely.
+            while(i < gaps_.size())
+            {
+                auto& next = gaps_[i];
+                const auto between = distance(first, next.first) - length;
+                const auto merged = distance(first, next.first) + next.length;
+
+                if((between > config_.mergeDistance) || (merged > longest) || !due(next, now))
+                {
+                    break;
+                }
+
+                length = merged;
+                gaps_[i++].requested = now;
+            }
+
+            request(first, length);
+            ++requests;
+        }
+
+        return requests;
+    }
+
+    template<typename SequenceType, class Base>
+    void GapTracker<SequenceType, Base>::clear()
+    {
+        gaps_.clear();
+        missing_ = 0;
+    }
+
+    template<typename SequenceType, class Base>
+    void GapTracker<SequenceType, Base>::close(const SequenceType start, const std::size_t length)
+    {
+        if(gaps_.empty() || (length == 0))
+        {
+            return;
+        }
+
+        // offsets from the oldest gap, fixed while gaps are trimmed or erased below.
+        const auto origin = gaps_.front().first;
+        const std::size_t begin = distance(origin, start);
+        const std::size_t end = begin + length;
+
+        // the first gap ending after @start.
+        std::size_t low = 0;
+        std::size_t high = gaps_.size();
+
+        while(low < high)
+        {
+            const std::size_t middle = low + (high - low) / 2;
+            if(distance(origin, gaps_[middle].first) + gaps_[middle].length <= begin)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        std::size_t i = low;
+        while((i < gaps_.size()) && (distance(origin, gaps_[i].first) < end))
+        {
+            auto& gap = gaps_[i];
+
+            const std::size_t gapBegin = distance(origin, gap.first);
+            const std::size_t gapEnd = gapBegin + gap.length;
+
+            const std::size_t closeBegin = gapBegin > begin ? gapBegin : begin;
+            const std::size_t closeEnd = gapEnd < end ? gapEnd : end;
+
+            missing_ -= closeEnd - closeBegin;
+
+            if((closeBegin == gapBegin) && (closeEnd == gapEnd))
+            {
+                gaps_.erase(gaps_.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            else if(closeBegin == gapBegin)
+            {
+                gap.first = advance(origin, closeEnd);
+                gap.length = gapEnd - closeEnd;
+                ++i;
+            }
+            else if(closeEnd == gapEnd)
+            {
+                gap.length = closeBegin - gapBegin;
+                ++i;
+            }
+            else
+            {
+                // filled in the middle, split in two.
+                auto tail = gap;
+                tail.first = advance(origin, closeEnd);
+                tail.length = gapEnd - closeEnd;
+
+                gap.length = closeBegin - gapBegin;
+                gaps_.insert(gaps_.begin() + static_cast<std::ptrdiff_t>(i) + 1, tail);
+                i += 2;
+            }
+        }
+    }
+
+    template<typename SequenceType, class Base>
+    bool GapTracker<SequenceType, Base>::due(OpenGap& gap, const std::uint64_t now) const
+    {
+        if(gap.opened == Never)
+        {
+            gap.opened = now;
+        }
+
+        return (now - gap.opened >= config_.delay) &&
+               ((gap.requested == Never) || (now - gap.requested >= config_.retryInterval));
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter {
+
+    class HistoryPool;
+
+    // Run time sizing for arbiters whose Traits select HistoryLayout::Dynamic.
+    struct HistoryConfig
+    {
+        HistoryConfig(const std::size_t numberOfLines, const std::size_t historyDepth, const bool hugePages = false, HistoryPool* pool = nullptr);
+
+        std::size_t numberOfLines;  // at most Traits::NumberOfLines()
+        std::size_t historyDepth;
+        bool hugePages;             // ask the kernel to back the history with huge pages, ignored with @pool
+        HistoryPool* pool;          // carve the history out of @pool instead of allocating it
+
+        // Time bounded history, requires Traits::ArrivalTimestamps(). Head grows the history
+        // (doubling, up to maxHistoryDepth slots reserved up front) rather than overwrite a slot
+        // which arrived less than minimumAge ticks ago while a line is missing it or positioned at it.
+        std::size_t maxHistoryDepth;    // historyDepth by default, the history never grows
+        std::uint64_t minimumAge;       // 0 by default, slots are overwritten by depth alone
+
+        // Adaptive history depth, between historyDepth and maxHistoryDepth slots. The slowest line's
+        // lag behind head is sampled on each head advance. The history doubles once the lag times
+        // lagHeadroom reaches its depth and head nears its end, or at once should a line be overrun
+        // first. It halves at the end of a window of adaptInterval advances when the window's
+        // lagPercentile times lagHeadroom fits in half of it, as head reaches the end of that half.
+        double lagPercentile;           // e.g. 0.99, 0 by default, the depth doesn't adapt
+        double lagHeadroom;             // 2 by default
+        std::size_t adaptInterval;      // 65536 by default
+    };
+}
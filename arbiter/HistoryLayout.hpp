@@ -0,0 +1,14 @@
+#pragma once
+
+namespace arbiter {
+
+    // How the arbiter's history is laid out in memory, Traits
+    // select one with static constexpr HistoryLayout Layout().
+    enum class HistoryLayout
+    {
+        ArrayOfStructures,  // default, one SequenceInfo per slot
+        StructureOfArrays,  // a dense array of sequence numbers next to a dense array of line masks
+        ImplicitSequence,   // a dense array of line masks, sequence numbers are derived from head
+        Dynamic,            // StructureOfArrays sized at run time from a HistoryConfig
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <arbiter/details/AlignedBuffer.hpp>
+#include <cstddef>
+
+namespace arbiter {
+
+    // One aligned block runtime sized histories are carved out of, so many
+    // arbiters (e.g. one per stream) share a single allocation. Memory is
+    // handed out in cache line multiples and only returned when the pool
+    // is destroyed, the pool must outlive the arbiters using it.
+    class HistoryPool
+    {
+    public:
+        HistoryPool(const std::size_t bytes, const bool hugePages = false);
+
+        // a cache line aligned block of @bytes, throws std::bad_alloc when the pool is exhausted.
+        unsigned char* allocate(const std::size_t bytes);
+
+        std::size_t capacity() const { return buffer_.size(); }
+        std::size_t used() const { return used_; }
+
+    private:
+        details::AlignedBuffer buffer_;
+        std::size_t used_;
+    };
+}
@@ -0,0 +1,270 @@
+#pragma once
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/AlignedBuffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace arbiter {
+
+    // Arbitrates many independent streams (e.g. multicast channels), each
+    // with its own lines, using one SequenceArbiter<Traits> per stream.
+    // The arbiters live in a single cache line aligned slab allocated up
+    // front, adding a stream constructs an arbiter in place and validating
+    // never allocates. With HistoryLayout::Dynamic each stream may have
+    // its own history depth and line count. Stream ids below @denseStreamIds are found by direct
+    // index, any other id through an open addressing hash table.
+    // Every stream reports errors to the same ErrorReportingPolicy.
+    template<class Traits>
+    class MultiStreamSequenceArbiter
+    {
+    public:
+        using Arbiter = SequenceArbiter<Traits>;
+        using SequenceType = typename Traits::SequenceType;
+        using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
+
+        MultiStreamSequenceArbiter(ErrorReportingPolicy& errorPolicy, const std::size_t maxStreams, const std::size_t denseStreamIds = 0);
+        ~MultiStreamSequenceArbiter();
+
+        MultiStreamSequenceArbiter(const MultiStreamSequenceArbiter&) = delete;
+        MultiStreamSequenceArbiter& operator=(const MultiStreamSequenceArbiter&) = delete;
+
+        // construct the arbiter for @streamId, throws DuplicateStream or StreamCapacityExceeded.
+        Arbiter& addStream(const std::size_t streamId);
+
+        // as above, sizing the stream's history from @config (HistoryLayout::Dynamic only).
+        Arbiter& addStream(const std::size_t streamId, const HistoryConfig& config);
+
+        inline Arbiter* find(const std::size_t streamId);   // nullptr if @streamId hasn't been added
+        inline Arbiter& stream(const std::size_t streamId); // throws UnknownStream
+
+        // SequenceArbiter::validate() / validateBatch() / validateRange() for @streamId, throws UnknownStream.
+        inline bool validate(const std::size_t streamId, const std::size_t line, const SequenceType sequenceNumber);
+        inline std::size_t validateBatch(const std::size_t streamId, const std::size_t line, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept);
+        inline AcceptedRange<SequenceType> validateRange(const std::size_t streamId, const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count);
+
+        template<std::size_t Capacity>
+        inline std::size_t validateRange(const std::size_t streamId, const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count, AcceptedIntervals<SequenceType, Capacity>& intervals);
+
+        void reset(const std::size_t streamId);
+        void reset();   // every stream
+
+        std::size_t size() const { return streams_; }
+        std::size_t capacity() const { return maxStreams_; }
+
+    private:
+        static constexpr std::size_t SlotSize = details::AlignedBuffer::align(sizeof(Arbiter));
+
+        static_assert(alignof(Arbiter) <= details::AlignedBuffer::CacheLineSize, "SequenceArbiter alignment exceeds a cache line.");
+
+        static constexpr std::uint32_t NoSlot = 0;  // table values are slot + 1
+
+        struct SparseEntry
+        {
+            std::size_t streamId;
+            std::uint32_t slot;
+        };
+
+        inline Arbiter& arbiterAt(const std::uint32_t slot);
+        inline std::size_t probeStart(const std::size_t streamId) const;
+
+        inline std::uint32_t reserveSlot(const std::size_t streamId);
+
+        inline std::uint32_t lookup(const std::size_t streamId) const;
+        void insert(const std::size_t streamId, const std::uint32_t slot);
+
+    private:
+        ErrorReportingPolicy& errorPolicy_;
+
+        const std::size_t maxStreams_;
+        std::size_t streams_;
+
+        details::AlignedBuffer slab_;
+
+        std::vector<std::uint32_t> dense_;      // indexed by stream id
+        std::vector<SparseEntry> sparse_;       // power of two sized, linear probing
+        std::size_t sparseMask_;
+    };
+
+
+    template<class Traits>
+    constexpr std::uint32_t MultiStreamSequenceArbiter<Traits>::NoSlot;
+
+    template<class Traits>
+    MultiStreamSequenceArbiter<Traits>::MultiStreamSequenceArbiter(ErrorReportingPolicy& errorPolicy, const std::size_t maxStreams, const std::size_t denseStreamIds)
+        : errorPolicy_(errorPolicy)
+        , maxStreams_(maxStreams)
+        , streams_(0)
+        , slab_(maxStreams * SlotSize, false)
+        , dense_(denseStreamIds, NoSlot)
+        , sparseMask_(0)
+    {
+        // keep the sparse table at most half full.
+        std::size_t sparseSize = 2;
+        while(sparseSize < 2 * maxStreams)
+        {
+            sparseSize *= 2;
+        }
+
+        sparse_.assign(sparseSize, SparseEntry{0, NoSlot});
+        sparseMask_ = sparseSize - 1;
+    }
+
+    template<class Traits>
+    MultiStreamSequenceArbiter<Traits>::~MultiStreamSequenceArbiter()
+    {
+        for(std::size_t slot = 0; slot < streams_; ++slot)
+        {
+            arbiterAt(static_cast<std::uint32_t>(slot)).~Arbiter();
+        }
+    }
+
+    template<class Traits>
+    typename MultiStreamSequenceArbiter<Traits>::Arbiter& MultiStreamSequenceArbiter<Traits>::addStream(const std::size_t streamId)
+    {
+        const auto slot = reserveSlot(streamId);
+        new (slab_.data() + slot * SlotSize) Arbiter(errorPolicy_);
+        ++streams_;
+
+        insert(streamId, slot);
+        return arbiterAt(slot);
+    }
+
+    template<class Traits>
+    typename MultiStreamSequenceArbiter<Traits>::Arbiter& MultiStreamSequenceArbiter<Traits>::addStream(const std::size_t streamId, const HistoryConfig& config)
+    {
+        const auto slot = reserveSlot(streamId);
+        new (slab_.data() + slot * SlotSize) Arbiter(errorPolicy_, config);
+        ++streams_;
+
+        insert(streamId, slot);
+        return arbiterAt(slot);
+    }
+
+    template<class Traits>
+    typename MultiStreamSequenceArbiter<Traits>::Arbiter* MultiStreamSequenceArbiter<Traits>::find(const std::size_t streamId)
+    {
+        const auto slot = lookup(streamId);
+        return slot == NoSlot ? nullptr : &arbiterAt(slot - 1);
+    }
+
+    template<class Traits>
+    typename MultiStreamSequenceArbiter<Traits>::Arbiter& MultiStreamSequenceArbiter<Traits>::stream(const std::size_t streamId)
+    {
+        const auto slot = lookup(streamId);
+        if(slot == NoSlot)
+        {
+            throw UnknownStream(streamId);
+        }
+
+        return arbiterAt(slot - 1);
+    }
+
+    template<class Traits>
+    bool MultiStreamSequenceArbiter<Traits>::validate(const std::size_t streamId, const std::size_t line, const SequenceType sequenceNumber)
+    {
+        return stream(streamId).validate(line, sequenceNumber);
+    }
+
+    template<class Traits>
+    std::size_t MultiStreamSequenceArbiter<Traits>::validateBatch(const std::size_t streamId, const std::size_t line, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept)
+    {
+        return stream(streamId).validateBatch(line, sequenceNumbers, count, accept);
+    }
+
+    template<class Traits>
+    AcceptedRange<typename Traits::SequenceType> MultiStreamSequenceArbiter<Traits>::validateRange(const std::size_t streamId, const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count)
+    {
+        return stream(streamId).validateRange(line, firstSequenceNumber, count);
+    }
+
+    template<class Traits>
+    template<std::size_t Capacity>
+    std::size_t MultiStreamSequenceArbiter<Traits>::validateRange(const std::size_t streamId, const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count, AcceptedIntervals<SequenceType, Capacity>& intervals)
+    {
+        return stream(streamId).validateRange(line, firstSequenceNumber, count, intervals);
+    }
+
+    template<class Traits>
+    void MultiStreamSequenceArbiter<Traits>::reset(const std::size_t streamId)
+    {
+        stream(streamId).reset();
+    }
+
+    template<class Traits>
+    void MultiStreamSequenceArbiter<Traits>::reset()
+    {
+        for(std::size_t slot = 0; slot < streams_; ++slot)
+        {
+            arbiterAt(static_cast<std::uint32_t>(slot)).reset();
+        }
+    }
+
+    template<class Traits>
+    typename MultiStreamSequenceArbiter<Traits>::Arbiter& MultiStreamSequenceArbiter<Traits>::arbiterAt(const std::uint32_t slot)
+    {
+        return *reinterpret_cast<Arbiter*>(slab_.data() + slot * SlotSize);
+    }
+
+    template<class Traits>
+    std::size_t MultiStreamSequenceArbiter<Traits>::probeStart(const std::size_t streamId) const
+    {
+        // fibonacci hashing, spreads sequential ids across the table.
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(streamId) * 0x9E3779B97F4A7C15ULL) >> 32) & sparseMask_;
+    }
+
+    template<class Traits>
+    std::uint32_t MultiStreamSequenceArbiter<Traits>::reserveSlot(const std::size_t streamId)
+    {
+        if(lookup(streamId) != NoSlot)
+        {
+            throw DuplicateStream(streamId);
+        }
+
+        if(streams_ == maxStreams_)
+        {
+            throw StreamCapacityExceeded(maxStreams_);
+        }
+
+        return static_cast<std::uint32_t>(streams_);
+    }
+
+    template<class Traits>
+    std::uint32_t MultiStreamSequenceArbiter<Traits>::lookup(const std::size_t streamId) const
+    {
+        if(streamId < dense_.size())
+        {
+            return dense_[streamId];
+        }
+
+        for(std::size_t i = probeStart(streamId);; i = (i + 1) & sparseMask_)
+        {
+            const auto& entry = sparse_[i];
+            if((entry.slot == NoSlot) || (entry.streamId == streamId))
+            {
+                return entry.slot;
+            }
+        }
+    }
+
+    template<class Traits>
+    void MultiStreamSequenceArbiter<Traits>::insert(const std::size_t streamId, const std::uint32_t slot)
+    {
+        if(streamId < dense_.size())
+        {
+            dense_[streamId] = slot + 1;
+            return;
+        }
+
+        std::size_t i = probeStart(streamId);
+        while(sparse_[i].slot != NoSlot)
+        {
+            i = (i + 1) & sparseMask_;
+        }
+
+        sparse_[i] = SparseEntry{streamId, slot + 1};
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <arbiter/details/BitOperations.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter {
+
+    // An ErrorReportingPolicy which records, per line, how often the line won
+    // the race (delivered a sequence number first) and log2 bucketed
+    // histograms of how far it lagged the winner when it didn't: in messages
+    // (how far head was ahead) and, when the arbiter's Traits define
+    // ArrivalTimestamps() and messages are validated with a timestamp, in the
+    // caller's clock ticks. Every other callback is inherited from @Base, so
+    // the statistics compose with another policy, e.g.
+    // RaceStatistics<std::uint64_t, 2, StatsErrorReportingPolicy<std::uint64_t, 2>>.
+    // Counters are written by the arbiter's thread only and may be read from
+    // any thread, each counter individually.
+    template<typename SequenceType, std::size_t NumberOfLines, class Base = details::NullErrorReportingPolicy<SequenceType>>
+    class RaceStatistics : public Base
+    {
+    public:
+        // bucket 0 counts 0, bucket b counts values in [2^(b-1), 2^b).
+        static constexpr std::size_t HistogramBuckets = 65;
+        using Histogram = std::array<std::uint64_t, HistogramBuckets>;
+
+        RaceStatistics();
+
+        RaceStatistics(const RaceStatistics&) = delete;
+        RaceStatistics& operator=(const RaceStatistics&) = delete;
+
+        void FirstArrival(const std::size_t line, const SequenceType sequence);
+        void LateArrival(const std::size_t line, const SequenceType sequence, const SequenceType lagMessages, const std::uint64_t lagTicks);
+
+        std::uint64_t wins(const std::size_t line) const { return read(lines_[line].wins); }
+        std::uint64_t losses(const std::size_t line) const { return read(lines_[line].losses); }
+
+        Histogram lagMessages(const std::size_t line) const { return histogram(lines_[line].lagMessages); }
+        Histogram lagTicks(const std::size_t line) const { return histogram(lines_[line].lagTicks); }
+
+        static std::size_t bucket(const std::uint64_t value) { return details::bitWidth(value); }
+
+    private:
+        using Counter = std::atomic<std::uint64_t>;
+        using Counters = std::array<Counter, HistogramBuckets>;
+
+        struct LineCounters
+        {
+            Counter wins;
+            Counter losses;
+
+            Counters lagMessages;
+            Counters lagTicks;
+        };
+
+        static inline void add(Counter& counter);
+        static inline std::uint64_t read(const Counter& counter);
+
+        static Histogram histogram(const Counters& counters);
+
+    private:
+        std::array<LineCounters, NumberOfLines> lines_;
+    };
+
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    constexpr std::size_t RaceStatistics<SequenceType, NumberOfLines, Base>::HistogramBuckets;
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    RaceStatistics<SequenceType, NumberOfLines, Base>::RaceStatistics()
+    {
+        for(auto& line : lines_)
+        {
+            line.wins.store(0, std::memory_order_relaxed);
+            line.losses.store(0, std::memory_order_relaxed);
+
+            for(std::size_t i = 0; i < HistogramBuckets; ++i)
+            {
+                line.lagMessages[i].store(0, std::memory_order_relaxed);
+                line.lagTicks[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    void RaceStatistics<SequenceType, NumberOfLines, Base>::FirstArrival(const std::size_t line, const SequenceType)
+    {
+        add(lines_[line].wins);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    void RaceStatistics<SequenceType, NumberOfLines, Base>::LateArrival(const std::size_t line, const SequenceType, const SequenceType lagMessages, const std::uint64_t lagTicks)
+    {
+        auto& counters = lines_[line];
+
+        add(counters.losses);
+        add(counters.lagMessages[bucket(static_cast<std::uint64_t>(lagMessages))]);
+        add(counters.lagTicks[bucket(lagTicks)]);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    void RaceStatistics<SequenceType, NumberOfLines, Base>::add(Counter& counter)
+    {
+        // single writer, a plain load and store avoids a locked instruction.
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    std::uint64_t RaceStatistics<SequenceType, NumberOfLines, Base>::read(const Counter& counter)
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, class Base>
+    typename RaceStatistics<SequenceType, NumberOfLines, Base>::Histogram RaceStatistics<SequenceType, NumberOfLines, Base>::histogram(const Counters& counters)
+    {
+        Histogram histogram;
+        for(std::size_t i = 0; i < HistogramBuckets; ++i)
+        {
+            histogram[i] = read(counters[i]);
+        }
+
+        return histogram;
+    }
+}
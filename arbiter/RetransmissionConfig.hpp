@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter {
+
+    // How GapTracker turns open gaps into retransmission requests. Times are in the
+    // caller's clock ticks, as passed to GapTracker::requestRetransmissions().
+    struct RetransmissionConfig
+    {
+        RetransmissionConfig(const std::uint64_t delay, const std::uint64_t retryInterval, const std::size_t mergeDistance = 0, const std::size_t maxRangeLength = 1000, const std::size_t maxRequests = 16);
+
+        std::uint64_t delay;            // a gap is requested once open this long, another line may fill it first
+        std::uint64_t retryInterval;    // a requested gap still open is requested again after this long
+        std::size_t mergeDistance;      // gaps at most this many delivered sequence numbers apart are requested as one range
+        std::size_t maxRangeLength;     // longest range of a single request
+        std::size_t maxRequests;        // most requests per call to requestRetransmissions()
+    };
+}
@@ -1,8 +1,14 @@
 #pragma once 
+#include <arbiter/AcceptedIntervals.hpp>
+#include <arbiter/AcceptedRange.hpp>
+#include <arbiter/HistoryConfig.hpp>
+#include <arbiter/HistoryLayout.hpp>
 #include <arbiter/details/ArbiterCache.hpp>
 #include <arbiter/details/ArbiterCacheAdvancer.hpp>
+#include <arbiter/details/ArbiterSnapshot.hpp>
 
 #include <cstddef>
+#include <cstdint>
 
 namespace arbiter {
 
@@ -18,6 +24,8 @@ namespace arbiter {
 	// will be reported and the lagging line's position moved forward.
 	// If we find we're replacing sequences having gaps, an unrecoverable 
 	// gap error will be reported. 
+	// The ErrorReportingPolicy is held by reference unless Traits defines
+	// static constexpr bool ErrorReportingPolicyByValue() { return true; }.
 	template<class Traits>
 	class SequenceArbiter 
 	{
@@ -25,18 +33,67 @@ namespace arbiter {
 		using SequenceType = typename Traits::SequenceType;
 		using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
 
+		// a policy held by value is copied from @errorPolicy.
 		SequenceArbiter(ErrorReportingPolicy& errorPolicy);
+
+        // size the history at run time, requires Traits::Layout() to be HistoryLayout::Dynamic.
+        SequenceArbiter(ErrorReportingPolicy& errorPolicy, const HistoryConfig& config);
+
+        // default construct a policy held by value.
+        SequenceArbiter();
+        explicit SequenceArbiter(const HistoryConfig& config);
 		
 		// Determine wether we should accept the @sequenceNumber or reject it
         inline bool validate(const std::size_t line, const SequenceType sequenceNumber);
 
+        // Validate @count sequence numbers received together on @line (e.g. one datagram).
+        // @accept[i] is set to whether @sequenceNumbers[i] should be accepted, error reporting
+        // is identical to calling validate() for each sequence number in turn.
+        // Returns the number of accepted sequence numbers.
+        inline std::size_t validateBatch(const std::size_t line, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept);
+
+        // Validate a packet on @line carrying the @count consecutive sequence numbers from
+        // @firstSequenceNumber (e.g. MoldUDP64, where the sequence number advances by the
+        // packet's message count). Returns the part of the packet to accept, empty when every
+        // sequence number was already seen, a sub-range when another line delivered part of it.
+        inline AcceptedRange<SequenceType> validateRange(const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count);
+
+        // as above, writing the accepted sub-intervals of the packet to @intervals in order, e.g. 150-169
+        // of a 120-169 packet when another line already delivered 100-149. Returns the number accepted.
+        template<std::size_t Capacity>
+        inline std::size_t validateRange(const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count, AcceptedIntervals<SequenceType, Capacity>& intervals);
+
+        // as above, @timestamp is when the message(s) arrived (e.g. TSC ticks). Requires
+        // Traits::ArrivalTimestamps(), the policy's LateArrival() is then given the lag in ticks.
+        inline bool validate(const std::size_t line, const SequenceType sequenceNumber, const std::uint64_t timestamp);
+        inline std::size_t validateBatch(const std::size_t line, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept, const std::uint64_t timestamp);
+
         // Return SequenceArbiter to initial state.
 		inline void reset();
 
-	private:
+        // bytes of a snapshot of this arbiter.
+        inline std::size_t snapshotSize() const;
+
+        // Write the line positions, head and history to @buffer (snapshotSize() bytes, 8 byte aligned) for a standby
+        // to restore(). Slots unchanged in @buffer aren't rewritten. With Traits::IncrementalSnapshots() only
+        // the history slots written since this arbiter's last snapshot into @buffer are encoded, so checkpointing
+        // into the same buffer (e.g. shared memory) costs the slots changed since rather than the history depth.
+        // Returns the slots written.
+        inline std::size_t snapshot(void* buffer);
 
-		ErrorReportingPolicy& errorPolicy_;  // TODO: move this to policy holder idiom
+        // Carry on from a snapshot() written by an arbiter with the same Traits (and HistoryConfig).
+        // Throws InvalidSnapshot if @buffer doesn't hold one, holds an out of range head or line position,
+        // or its writer stopped part way through or started over while it was read (read it again), and
+        // leaves the arbiter as it was.
+        inline void restore(const void* buffer);
 
+        // slots of history in use, Traits::HistoryDepth() or HistoryConfig::historyDepth
+        // unless a time bounded history has grown.
+        std::size_t historyDepth() const { return cache_.history.size(); }
+
+        ErrorReportingPolicy& errorPolicy() { return advance_.errorPolicy(); }
+
+	private:
         details::ArbiterCache<Traits> cache_;
         details::ArbiterCacheAdvancer<Traits> advance_;
     };
@@ -44,16 +101,36 @@ namespace arbiter {
 	
 	template<class Traits>
 	SequenceArbiter<Traits>::SequenceArbiter(ErrorReportingPolicy& errorPolicy)
-        : errorPolicy_(errorPolicy)
-        , advance_(cache_, errorPolicy_)
+        : advance_(cache_, errorPolicy)
+	{
+    }
+
+	template<class Traits>
+	SequenceArbiter<Traits>::SequenceArbiter(ErrorReportingPolicy& errorPolicy, const HistoryConfig& config)
+        : cache_(config)
+        , advance_(cache_, errorPolicy)
 	{
     }
 
+	template<class Traits>
+	SequenceArbiter<Traits>::SequenceArbiter()
+        : advance_(cache_)
+	{
+        static_assert(details::OptionalTraits<Traits>::ErrorReportingPolicyByValue(), "SequenceArbiter() requires Traits::ErrorReportingPolicyByValue(), otherwise pass an ErrorReportingPolicy.");
+    }
+
+	template<class Traits>
+	SequenceArbiter<Traits>::SequenceArbiter(const HistoryConfig& config)
+        : cache_(config)
+        , advance_(cache_)
+	{
+        static_assert(details::OptionalTraits<Traits>::ErrorReportingPolicyByValue(), "SequenceArbiter(config) requires Traits::ErrorReportingPolicyByValue(), otherwise pass an ErrorReportingPolicy.");
+    }
+
 	template<class Traits>
 	void SequenceArbiter<Traits>::reset()
 	{
-        cache_.reset();
-        advance_.reset();
+        cache_.reset();     // head returns to NoHead, the next message is handled as the first
 	}
 
 	template<class Traits>
@@ -61,4 +138,59 @@ namespace arbiter {
 	{
         return advance_(line, sequenceNumber);
     }
+
+	template<class Traits>
+	std::size_t SequenceArbiter<Traits>::validateBatch(const std::size_t line, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept)
+	{
+        return advance_(line, sequenceNumbers, count, accept);
+    }
+
+	template<class Traits>
+	AcceptedRange<typename Traits::SequenceType> SequenceArbiter<Traits>::validateRange(const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count)
+	{
+        return advance_(line, firstSequenceNumber, count);
+    }
+
+	template<class Traits>
+	template<std::size_t Capacity>
+	std::size_t SequenceArbiter<Traits>::validateRange(const std::size_t line, const SequenceType firstSequenceNumber, const std::size_t count, AcceptedIntervals<SequenceType, Capacity>& intervals)
+	{
+        return advance_(line, firstSequenceNumber, count, intervals);
+    }
+
+	template<class Traits>
+	bool SequenceArbiter<Traits>::validate(const std::size_t line, const SequenceType sequenceNumber, const std::uint64_t timestamp)
+	{
+        static_assert(details::OptionalTraits<Traits>::ArrivalTimestamps(), "validate(line, sequenceNumber, timestamp) requires Traits::ArrivalTimestamps().");
+
+        cache_.arrivals().now(timestamp);
+        return advance_(line, sequenceNumber);
+    }
+
+	template<class Traits>
+	std::size_t SequenceArbiter<Traits>::validateBatch(const std::size_t line, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept, const std::uint64_t timestamp)
+	{
+        static_assert(details::OptionalTraits<Traits>::ArrivalTimestamps(), "validateBatch(..., timestamp) requires Traits::ArrivalTimestamps().");
+
+        cache_.arrivals().now(timestamp);
+        return advance_(line, sequenceNumbers, count, accept);
+    }
+
+	template<class Traits>
+	std::size_t SequenceArbiter<Traits>::snapshotSize() const
+	{
+        return details::ArbiterSnapshot<Traits>::size(cache_);
+    }
+
+	template<class Traits>
+	std::size_t SequenceArbiter<Traits>::snapshot(void* buffer)
+	{
+        return details::ArbiterSnapshot<Traits>::write(cache_, buffer);
+    }
+
+	template<class Traits>
+	void SequenceArbiter<Traits>::restore(const void* buffer)
+	{
+        details::ArbiterSnapshot<Traits>::read(cache_, buffer);
+    }
 }
@@ -0,0 +1,269 @@
+#pragma once
+#include <arbiter/details/BitOperations.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter {
+
+    // An ErrorReportingPolicy which counts every event, per line where the
+    // event names a line, and keeps log2 bucketed histograms of gap lengths
+    // and of gap fill latency (how many sequence numbers head was ahead of a
+    // gap when it was filled). The arbiter's thread is the only writer: the
+    // counters are relaxed atomics bumped without read-modify-write
+    // instructions and each event is published under a sequence lock, so a
+    // monitoring thread can take a consistent snapshot() at any time without
+    // locks and without stalling the writer.
+    template<typename SequenceType, std::size_t NumberOfLines>
+    class StatsErrorReportingPolicy
+    {
+    public:
+        // bucket 0 counts 0, bucket b counts values in [2^(b-1), 2^b).
+        static constexpr std::size_t HistogramBuckets = 65;
+        using Histogram = std::array<std::uint64_t, HistogramBuckets>;
+
+        struct LineStats
+        {
+            std::uint64_t firstSequenceNumberOutOfSequence;
+            std::uint64_t duplicates;
+            std::uint64_t overruns;                 // times head overran this line
+            std::uint64_t unrecoverableLineGaps;
+        };
+
+        struct Snapshot
+        {
+            std::array<LineStats, NumberOfLines> lines;
+
+            std::uint64_t gaps;
+            std::uint64_t gapMessages;              // sequence numbers missing when the gaps were detected
+            std::uint64_t gapFills;
+            std::uint64_t unrecoverableGaps;
+            std::uint64_t unrecoverableGapMessages;
+
+            Histogram gapLength;
+            Histogram gapFillLatency;
+        };
+
+        StatsErrorReportingPolicy();
+
+        StatsErrorReportingPolicy(const StatsErrorReportingPolicy&) = delete;
+        StatsErrorReportingPolicy& operator=(const StatsErrorReportingPolicy&) = delete;
+
+        void FirstSequenceNumberOutOfSequence(const std::size_t line, const SequenceType sequence);
+        void DuplicateOnLine(const std::size_t line, const SequenceType sequence);
+
+        void Gap(const SequenceType start, const SequenceType length);
+        void GapFill(const SequenceType start, const SequenceType length);
+        void GapFillLatency(const SequenceType sequence, const SequenceType latency);
+
+        void LinePositionOverrun(const std::size_t slowLine, const std::size_t overrunByLine);
+
+        void UnrecoverableGap(const SequenceType start, const SequenceType length = 1);
+        void UnrecoverableLineGap(const std::size_t line, const SequenceType sequenceNumber);
+
+        // a consistent copy of every counter, safe to call from any thread.
+        Snapshot snapshot() const;
+
+        static std::size_t bucket(const std::uint64_t value) { return details::bitWidth(value); }
+
+    private:
+        using Counter = std::atomic<std::uint64_t>;
+
+        struct LineCounters
+        {
+            Counter firstSequenceNumberOutOfSequence;
+            Counter duplicates;
+            Counter overruns;
+            Counter unrecoverableLineGaps;
+        };
+
+        // marks the writer's updates to the counters as one event for snapshot().
+        class Publish
+        {
+        public:
+            explicit Publish(Counter& version);
+            ~Publish();
+
+        private:
+            Counter& version_;
+            const std::uint64_t odd_;
+        };
+
+        static inline void add(Counter& counter, const std::uint64_t value = 1);
+        static inline std::uint64_t read(const Counter& counter);
+
+    private:
+        Counter version_;       // odd while the writer is publishing an event
+
+        std::array<LineCounters, NumberOfLines> lines_;
+
+        Counter gaps_;
+        Counter gapMessages_;
+        Counter gapFills_;
+        Counter unrecoverableGaps_;
+        Counter unrecoverableGapMessages_;
+
+        std::array<Counter, HistogramBuckets> gapLength_;
+        std::array<Counter, HistogramBuckets> gapFillLatency_;
+    };
+
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    constexpr std::size_t StatsErrorReportingPolicy<SequenceType, NumberOfLines>::HistogramBuckets;
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    StatsErrorReportingPolicy<SequenceType, NumberOfLines>::Publish::Publish(Counter& version)
+        : version_(version)
+        , odd_(version.load(std::memory_order_relaxed) + 1)
+    {
+        version_.store(odd_, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    StatsErrorReportingPolicy<SequenceType, NumberOfLines>::Publish::~Publish()
+    {
+        version_.store(odd_ + 1, std::memory_order_release);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    StatsErrorReportingPolicy<SequenceType, NumberOfLines>::StatsErrorReportingPolicy()
+    {
+        version_.store(0, std::memory_order_relaxed);
+
+        for(auto& line : lines_)
+        {
+            line.firstSequenceNumberOutOfSequence.store(0, std::memory_order_relaxed);
+            line.duplicates.store(0, std::memory_order_relaxed);
+            line.overruns.store(0, std::memory_order_relaxed);
+            line.unrecoverableLineGaps.store(0, std::memory_order_relaxed);
+        }
+
+        gaps_.store(0, std::memory_order_relaxed);
+        gapMessages_.store(0, std::memory_order_relaxed);
+        gapFills_.store(0, std::memory_order_relaxed);
+        unrecoverableGaps_.store(0, std::memory_order_relaxed);
+        unrecoverableGapMessages_.store(0, std::memory_order_relaxed);
+
+        for(std::size_t i = 0; i < HistogramBuckets; ++i)
+        {
+            gapLength_[i].store(0, std::memory_order_relaxed);
+            gapFillLatency_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::FirstSequenceNumberOutOfSequence(const std::size_t line, const SequenceType)
+    {
+        Publish publish(version_);
+        add(lines_[line].firstSequenceNumberOutOfSequence);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::DuplicateOnLine(const std::size_t line, const SequenceType)
+    {
+        Publish publish(version_);
+        add(lines_[line].duplicates);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::Gap(const SequenceType, const SequenceType length)
+    {
+        Publish publish(version_);
+        add(gaps_);
+        add(gapMessages_, static_cast<std::uint64_t>(length));
+        add(gapLength_[bucket(static_cast<std::uint64_t>(length))]);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::GapFill(const SequenceType, const SequenceType length)
+    {
+        Publish publish(version_);
+        add(gapFills_, static_cast<std::uint64_t>(length));
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::GapFillLatency(const SequenceType, const SequenceType latency)
+    {
+        Publish publish(version_);
+        add(gapFillLatency_[bucket(static_cast<std::uint64_t>(latency))]);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::LinePositionOverrun(const std::size_t slowLine, const std::size_t)
+    {
+        Publish publish(version_);
+        add(lines_[slowLine].overruns);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::UnrecoverableGap(const SequenceType, const SequenceType length)
+    {
+        Publish publish(version_);
+        add(unrecoverableGaps_);
+        add(unrecoverableGapMessages_, static_cast<std::uint64_t>(length));
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::UnrecoverableLineGap(const std::size_t line, const SequenceType)
+    {
+        Publish publish(version_);
+        add(lines_[line].unrecoverableLineGaps);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    typename StatsErrorReportingPolicy<SequenceType, NumberOfLines>::Snapshot StatsErrorReportingPolicy<SequenceType, NumberOfLines>::snapshot() const
+    {
+        Snapshot snapshot;
+
+        for(;;)
+        {
+            const auto version = version_.load(std::memory_order_acquire);
+            if((version & 1) != 0)
+            {
+                continue;   // the writer is mid event
+            }
+
+            for(std::size_t line = 0; line < NumberOfLines; ++line)
+            {
+                snapshot.lines[line].firstSequenceNumberOutOfSequence = read(lines_[line].firstSequenceNumberOutOfSequence);
+                snapshot.lines[line].duplicates = read(lines_[line].duplicates);
+                snapshot.lines[line].overruns = read(lines_[line].overruns);
+                snapshot.lines[line].unrecoverableLineGaps = read(lines_[line].unrecoverableLineGaps);
+            }
+
+            snapshot.gaps = read(gaps_);
+            snapshot.gapMessages = read(gapMessages_);
+            snapshot.gapFills = read(gapFills_);
+            snapshot.unrecoverableGaps = read(unrecoverableGaps_);
+            snapshot.unrecoverableGapMessages = read(unrecoverableGapMessages_);
+
+            for(std::size_t i = 0; i < HistogramBuckets; ++i)
+            {
+                snapshot.gapLength[i] = read(gapLength_[i]);
+                snapshot.gapFillLatency[i] = read(gapFillLatency_[i]);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(version_.load(std::memory_order_relaxed) == version)
+            {
+                return snapshot;
+            }
+        }
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    void StatsErrorReportingPolicy<SequenceType, NumberOfLines>::add(Counter& counter, const std::uint64_t value)
+    {
+        // single writer, a plain load and store avoids a locked instruction.
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines>
+    std::uint64_t StatsErrorReportingPolicy<SequenceType, NumberOfLines>::read(const Counter& counter)
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+}
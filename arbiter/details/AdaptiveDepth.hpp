@@ -0,0 +1,44 @@
+#pragma once
+#include <arbiter/HistoryConfig.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter { namespace details {
+
+    // The lag window behind adaptive history depth (HistoryConfig::lagPercentile): log2
+    // buckets of the slowest line's lag behind head, one sample per head advance, over
+    // windows of config.adaptInterval advances.
+    class AdaptiveDepth
+    {
+    public:
+        AdaptiveDepth();    // disabled
+        explicit AdaptiveDepth(const HistoryConfig& config);
+
+        bool enabled() const { return interval_ != 0; }
+
+        // true when a history of @depth slots leaves less than the headroom over @lag.
+        bool crowded(const std::size_t lag, const std::size_t depth) const { return static_cast<double>(lag) * headroom_ >= static_cast<double>(depth); }
+
+        // add @count samples of @lag, returns true when they end the window.
+        bool record(const std::size_t lag, const std::size_t count);
+
+        // the lag below which the window's percentile of samples fell, and start the next window.
+        std::size_t percentileLag();
+
+        void clear();
+
+        // throws InvalidHistoryConfig.
+        static const HistoryConfig& validate(const HistoryConfig& config);
+
+    private:
+        // bucket 0 counts 0, bucket b counts lags in [2^(b-1), 2^b).
+        std::array<std::uint64_t, 65> buckets_;
+        std::uint64_t samples_;
+
+        double percentile_;
+        double headroom_;
+        std::uint64_t interval_;      // 0 when disabled
+    };
+}}
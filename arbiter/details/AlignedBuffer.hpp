@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+
+namespace arbiter { namespace details {
+
+    // A cache line aligned heap block. With @hugePages the block is aligned
+    // to a huge page and, where supported (Linux), advised to use
+    // transparent huge pages.
+    class AlignedBuffer
+    {
+    public:
+        // members written by different threads are also kept this far apart, by padding rather
+        // than alignas() as C++11 new doesn't honour extended alignment.
+        static constexpr std::size_t CacheLineSize = 64;
+        static constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+
+        AlignedBuffer();
+        AlignedBuffer(const std::size_t bytes, const bool hugePages);
+        ~AlignedBuffer();
+
+        AlignedBuffer(AlignedBuffer&& other);
+        AlignedBuffer& operator=(AlignedBuffer&& other);
+
+        AlignedBuffer(const AlignedBuffer&) = delete;
+        AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+        unsigned char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+        // round @bytes up to a multiple of the cache line size.
+        static constexpr std::size_t align(const std::size_t bytes) { return (bytes + CacheLineSize - 1) / CacheLineSize * CacheLineSize; }
+
+    private:
+        void release();
+
+    private:
+        unsigned char* data_;
+        std::size_t size_;
+    };
+}}
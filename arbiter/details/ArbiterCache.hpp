@@ -1,63 +1,668 @@
 #pragma once
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/HistoryConfig.hpp>
+#include <arbiter/details/AdaptiveDepth.hpp>
+#include <arbiter/details/ArrayHistory.hpp>
+#include <arbiter/details/ArrivalTimes.hpp>
+#include <arbiter/details/BitOperations.hpp>
+#include <arbiter/details/BranchHints.hpp>
+#include <arbiter/details/ChangedSlots.hpp>
+#include <arbiter/details/ColumnHistory.hpp>
+#include <arbiter/details/DynamicHistory.hpp>
+#include <arbiter/details/EpochHistory.hpp>
+#include <arbiter/details/ImplicitHistory.hpp>
+#include <arbiter/details/OptionalTraits.hpp>
+#include <arbiter/details/SequenceArithmetic.hpp>
 #include <arbiter/details/SequenceInfo.hpp>
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <type_traits>
 
 namespace arbiter { namespace details {
 
+    // Arrival times and the slots changed since a snapshot are bases, so they take no space when disabled.
     template<class Traits>
     struct ArbiterCache
+        : private ArrivalTimes<OptionalTraits<Traits>::ArrivalTimestamps()>
+        , private ChangedSlots<OptionalTraits<Traits>::IncrementalSnapshots(), Traits::NumberOfLines()>
     {
     public:
         using SequenceType = typename Traits::SequenceType;
         using SeqInfo = details::SequenceInfo<SequenceType, Traits::NumberOfLines()>;
+        using Sequence = SequenceArithmetic<Traits>;
+
+        using RowHistory = typename std::conditional<OptionalTraits<Traits>::EpochReset(),
+            EpochHistory<SeqInfo, Traits::HistoryDepth()>,
+            ArrayHistory<SeqInfo, Traits::HistoryDepth()>>::type;
+
+        // each unrecoverable forward gap starts a segment of at least LargestRecoverableGap() + 1 slots.
+        static constexpr std::size_t ImplicitSegments = Traits::HistoryDepth() / (Traits::LargestRecoverableGap() + 1) + 2;
+
+        // Dynamic histories are sized from a HistoryConfig at run time, Traits::NumberOfLines()
+        // is then the most lines a config may ask for and Traits::HistoryDepth() the default depth.
+        static constexpr bool Dynamic = OptionalTraits<Traits>::Layout() == HistoryLayout::Dynamic;
+
+        using History = typename std::conditional<OptionalTraits<Traits>::Layout() == HistoryLayout::StructureOfArrays,
+            ColumnHistory<SequenceType, Traits::NumberOfLines(), Traits::HistoryDepth()>,
+            typename std::conditional<OptionalTraits<Traits>::Layout() == HistoryLayout::ImplicitSequence,
+                ImplicitHistory<SequenceType, Traits::NumberOfLines(), Traits::HistoryDepth(), ImplicitSegments>,
+            typename std::conditional<Dynamic,
+                DynamicHistory<SequenceType, Traits::NumberOfLines()>,
+                RowHistory>::type>::type>::type;
+
+        using Positions = typename std::conditional<Dynamic,
+            LinePositions,
+            std::array<std::size_t, Traits::NumberOfLines()>>::type;
 
         // verify Traits has these constexpr functions...
 		static_assert(std::is_same<SequenceType, decltype(Traits::FirstExpectedSequenceNumber())>::value, "Traits::FirstExpectedSequenceNumber() has mismatched type. Type must be the same as SequenceType");
 		static_assert(std::is_same<std::size_t, decltype(Traits::NumberOfLines())>::value, "Traits::NumberOfLines() doesn't return expected type.");
 		static_assert(std::is_same<std::size_t, decltype(Traits::HistoryDepth())>::value, "Traits::HistoryDepth() doesn't return expected type.");
+        static_assert(!OptionalTraits<Traits>::EpochReset() || OptionalTraits<Traits>::Layout() == HistoryLayout::ArrayOfStructures, "Traits::EpochReset() is only supported by the ArrayOfStructures history layout.");
+        static_assert(!OptionalTraits<Traits>::PowerOfTwoHistoryDepth() || isPowerOfTwo(Traits::HistoryDepth()), "Traits::PowerOfTwoHistoryDepth() requires Traits::HistoryDepth() to be a power of two.");
+
+        // true when positions wrap around a compile time sized history with a mask rather than a modulo.
+        static constexpr bool MaskedWrap = !Dynamic && isPowerOfTwo(Traits::HistoryDepth());
+
+        // true when the history may grow to keep slots younger than HistoryConfig::minimumAge.
+        static constexpr bool TimeBounded = Dynamic && OptionalTraits<Traits>::ArrivalTimestamps();
+
+        // head before the first sequence number has been accepted.
+        static constexpr std::size_t NoHead = std::numeric_limits<std::size_t>::max();
+
+        // no slot, see dropping().
+        static constexpr std::size_t NoPosition = std::numeric_limits<std::size_t>::max();
+
+        // the most slots a resize of a Dynamic history moves in one head advance, see adapt().
+        static constexpr std::size_t ResizeStep = 64;
+
+        using Arrivals = ArrivalTimes<OptionalTraits<Traits>::ArrivalTimestamps()>;
+        using Changes = ChangedSlots<OptionalTraits<Traits>::IncrementalSnapshots(), Traits::NumberOfLines()>;
 
         ArbiterCache();
+        explicit ArbiterCache(const HistoryConfig& config);    // Dynamic layout only
 
         void reset();
+        void reset(const std::size_t depth);    // as above, with a Dynamic history of @depth (at most capacity()) slots
         std::size_t nextPosition(const std::size_t lineId); // return the next position in history for line.
+        inline std::size_t wrap(const std::size_t position) const;  // return @position % history size.
+
+        // the most slots the history may grow to, its size unless time bounded.
+        std::size_t capacity() const { return capacity(IsDynamic()); }
+
+        // grow the history while one of the @count slots following @newest (head's) is younger
+        // than the minimum age and missing a line or holding a line's position, so writing
+        // them doesn't overwrite it. Each
+        // growth doubles the history (up to capacity()), moving the slots following @newest
+        // and the line positions among them. Does nothing unless TimeBounded.
+        inline void retain(const std::size_t newest, const std::size_t count);
+
+        // adaptive depth: sample the slowest line's lag behind @newest (head's) before head
+        // advances @count slots. Once the lag crowds the history it doubles, moving the slots
+        // following @newest, when head is within ResizeStep slots of the history's end or a line
+        // would be overrun otherwise. A window ending with its lag percentile fitting in half the
+        // history starts a shrink to that half, see dropping(). Returns the depth of the pending
+        // shrink, 0 when there's none. Always 0 unless Dynamic with HistoryConfig::lagPercentile set.
+        inline std::size_t adapt(const std::size_t newest, const std::size_t count);
+
+        // the next slot a pending shrink drops as head advances from @newest, NoPosition when
+        // there's none to drop now. The caller reports its missing lines then calls drop().
+        // While head is short of the end of the slots the shrink keeps, the slots beyond them are
+        // dropped a few per slot head advances, never past a line's position. Once head reaches
+        // the end, those it wrote past it (at most ResizeStep) are dropped from the history's start,
+        // else head is overwriting the slots dropped, they're dropped again after it wraps.
+        // A line crowding the depth, a grow(), or a slot younger than the minimum age cancels it.
+        inline std::size_t dropping(const std::size_t newest);
+        inline void drop(const std::size_t position);
+
+        // complete a pending shrink once every slot it drops is drop()ped: the slots head wrote
+        // past the end of those kept move to the history's start, as do the line positions among them.
+        inline void shrink(const std::size_t newest);
+
+        // true when head writing the @count slots following its own may reach a line's position,
+        // the caller then checks every line. Keeps a lower bound of the slots between head and
+        // the slowest line (lines only move away from head), spent by each call and recounted
+        // over the lines once it runs out, so this is one compare per head advance.
+        inline bool mayOverrun(const std::size_t count);
+
+        // write @count consecutive gap slots (no lines reported) starting at @position
+        // and sequence @firstSequence, wrapping around history in at most two contiguous
+        // spans. Returns the position following the last slot written.
+        std::size_t fillGap(std::size_t position, SequenceType firstSequence, std::size_t count);
+
+        // add @lineId to @count (at most history size) consecutive slots starting at
+        // @position, wrapping around history in at most two contiguous spans.
+        void insertLine(const std::size_t position, const std::size_t count, const std::size_t lineId);
+
+        // move @lineId, overrun by head writing the @count slots following its own, to @position.
+        void overrun(const std::size_t lineId, const std::size_t position, const std::size_t count);
+
+        Arrivals& arrivals() { return *this; }
+        Changes& changes() { return *this; }
+
+    private:
+        using IsDynamic = std::integral_constant<bool, Dynamic>;
+
+        static History makeHistory(const HistoryConfig& config, std::true_type /*dynamic*/) { return History(config); }
+        static History makeHistory(const HistoryConfig&, std::false_type /*dynamic*/) { return History(); }
+
+        static Positions linePositions(History& history, std::true_type /*dynamic*/) { return history.linePositions(); }
+        static Positions linePositions(History&, std::false_type /*dynamic*/) { return Positions(); }
+
+        inline std::size_t wrap(const std::size_t position, std::true_type /*dynamic*/) const;
+        inline std::size_t wrap(const std::size_t position, std::false_type /*dynamic*/) const;
+
+        std::size_t capacity(std::true_type /*dynamic*/) const { return history.capacity(); }
+        std::size_t capacity(std::false_type /*dynamic*/) const { return history.size(); }
+
+        void reset(const std::size_t depth, std::true_type /*dynamic*/) { history.reset(depth); }
+        void reset(const std::size_t, std::false_type /*dynamic*/) { history.reset(); }
+
+        void retain(const std::size_t newest, const std::size_t count, std::true_type /*time bounded*/);
+        void retain(const std::size_t, const std::size_t, std::false_type /*time bounded*/) {}
+
+        inline bool retains(const std::size_t position);
+        bool grow(const std::size_t newest);
+
+        std::size_t adapt(const std::size_t newest, const std::size_t count, std::true_type /*dynamic*/);
+        std::size_t adapt(const std::size_t, const std::size_t, std::false_type /*dynamic*/) { return 0; }
+
+        std::size_t dropping(const std::size_t newest, std::true_type /*dynamic*/);
+        std::size_t dropping(const std::size_t, std::false_type /*dynamic*/) { return NoPosition; }
+
+        void drop(const std::size_t position, std::true_type /*dynamic*/);
+        void drop(const std::size_t, std::false_type /*dynamic*/) {}
+
+        void shrink(const std::size_t newest, std::true_type /*dynamic*/);
+        void shrink(const std::size_t, std::false_type /*dynamic*/) {}
+
+        std::size_t dropLimit(const std::size_t newest) const;
+
+        std::size_t slowestLag(const std::size_t newest) const;
+
+        ARBITER_NOINLINE bool recountOverrunBudget(const std::size_t count);
+
+        static const HistoryConfig& validate(const HistoryConfig& config);
 
     public:
-		std::array<std::size_t, Traits::NumberOfLines()> positions;	// tracks where each line is in cache_.
-		std::array<SeqInfo, Traits::HistoryDepth()> history;      // stores the sequence counts.
+		History history;      // stores the sequence counts.
+		Positions positions;	// tracks where each line is in cache_.
+
+        std::size_t head;  // indicates the line which is ahead, NoHead until the first message is accepted.
 
-        std::size_t head;  // indicates the line which is ahead.
+    private:
+        std::uint64_t minimumAge_;
+        AdaptiveDepth adaptive_;
+
+        // a pending shrink: its depth (0 when none), the next slot it drops counting from its depth
+        // (past the history's size for those dropped from the start), and the slots it may drop
+        // ahead of head in this advance, up to (not including) @dropLimit_.
+        std::size_t shrinkDepth_;
+        std::size_t dropNext_;
+        std::size_t dropBudget_;
+        std::size_t dropLimit_;
+
+        std::size_t overrunBudget_;     // slots head may write before reaching a line, 0 to recount
     };
 
 
+    template<class Traits>
+    constexpr std::size_t ArbiterCache<Traits>::NoHead;
+
+    template<class Traits>
+    constexpr bool ArbiterCache<Traits>::TimeBounded;
+
+    template<class Traits>
+    constexpr std::size_t ArbiterCache<Traits>::NoPosition;
+
+    template<class Traits>
+    constexpr std::size_t ArbiterCache<Traits>::ResizeStep;
+
+
     template<class Traits>
     ArbiterCache<Traits>::ArbiterCache()
-        : head(std::numeric_limits<std::size_t>::max())
+        : Arrivals(Traits::HistoryDepth())
+        , history(makeHistory(HistoryConfig(Traits::NumberOfLines(), Traits::HistoryDepth()), IsDynamic()))
+        , positions(linePositions(history, IsDynamic()))
+        , head(NoHead)
+        , minimumAge_(0)
+        , shrinkDepth_(0)
+        , dropNext_(0)
+        , dropBudget_(0)
+        , dropLimit_(0)
+        , overrunBudget_(0)
     {
         reset();
     }
 
+    template<class Traits>
+    ArbiterCache<Traits>::ArbiterCache(const HistoryConfig& config)
+        : Arrivals(validate(config).maxHistoryDepth)
+        , history(makeHistory(config, IsDynamic()))
+        , positions(linePositions(history, IsDynamic()))
+        , head(NoHead)
+        , minimumAge_(config.minimumAge)
+        , adaptive_(config)
+        , shrinkDepth_(0)
+        , dropNext_(0)
+        , dropBudget_(0)
+        , dropLimit_(0)
+        , overrunBudget_(0)
+    {
+        static_assert(Dynamic, "a HistoryConfig requires Traits::Layout() to be HistoryLayout::Dynamic.");
+        reset();
+    }
+
     template<class Traits>
     void ArbiterCache<Traits>::reset()
     {
-        head = std::numeric_limits<std::size_t>::max();
+        head = NoHead;
 
 		for(auto& position : positions)
 		{
 			position = 0;
 		}
 
-        for(auto& historyValue : history)
+        history.reset();
+        adaptive_.clear();
+        shrinkDepth_ = 0;
+        overrunBudget_ = 0;
+        changes().invalidate();
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::reset(const std::size_t depth)
+    {
+        head = NoHead;
+
+        for(auto& position : positions)
         {
-            historyValue = SeqInfo();
+            position = 0;
         }
+
+        reset(depth, IsDynamic());
+        adaptive_.clear();
+        shrinkDepth_ = 0;
+        overrunBudget_ = 0;
+        changes().invalidate();
     }
 
     template<class Traits>
     std::size_t ArbiterCache<Traits>::nextPosition(const std::size_t lineId)
     {
-        return (positions[lineId] + 1) % history.size();
+        return wrap(positions[lineId] + 1);
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::wrap(const std::size_t position) const
+    {
+        return wrap(position, IsDynamic());
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::wrap(const std::size_t position, std::true_type) const
+    {
+        return history.wrap(position);
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::wrap(const std::size_t position, std::false_type) const
+    {
+        return MaskedWrap ? (position & (Traits::HistoryDepth() - 1)) : (position % Traits::HistoryDepth());
+    }
+
+    template<class Traits>
+    bool ArbiterCache<Traits>::mayOverrun(const std::size_t count)
+    {
+        if(ARBITER_LIKELY(count <= overrunBudget_))
+        {
+            overrunBudget_ -= count;
+            return false;
+        }
+
+        return recountOverrunBudget(count);
+    }
+
+    template<class Traits>
+    bool ArbiterCache<Traits>::recountOverrunBudget(const std::size_t count)
+    {
+        const std::size_t size = history.size();
+        const std::size_t headPosition = positions[head];
+
+        // a line in head's slot has size - 1 slots to go.
+        std::size_t budget = size - 1;
+        for(std::size_t lineId = 0; lineId < positions.size(); ++lineId)
+        {
+            if(lineId != head)
+            {
+                const std::size_t ahead = size - 1 - wrap(headPosition + size - positions[lineId]);
+                budget = ahead < budget ? ahead : budget;
+            }
+        }
+
+        if(count <= budget)
+        {
+            overrunBudget_ = budget - count;
+            return false;
+        }
+
+        overrunBudget_ = 0;     // the caller moves the lines it overruns
+        return true;
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::fillGap(std::size_t position, SequenceType firstSequence, std::size_t count)
+    {
+        const std::size_t historySize = history.size();
+
+        if(count >= historySize)
+        {
+            // only the last (historySize - 1) slots survive, the slot
+            // following them is where the caller writes next.
+            const std::size_t skip = count - (historySize - 1);
+
+            position = wrap(position + skip);
+            firstSequence = Sequence::advance(firstSequence, skip);
+            count = historySize - 1;
+        }
+
+        const std::size_t firstSpan = count < (historySize - position) ? count : (historySize - position);
+
+        history.fill(position, firstSequence, firstSpan);
+        history.fill(0, Sequence::advance(firstSequence, firstSpan), count - firstSpan);
+
+        arrivals().record(position, firstSpan);
+        arrivals().record(0, count - firstSpan);
+
+        return wrap(position + count);
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::insertLine(const std::size_t position, const std::size_t count, const std::size_t lineId)
+    {
+        const std::size_t historySize = history.size();
+        const std::size_t firstSpan = count < (historySize - position) ? count : (historySize - position);
+
+        history.insert(position, firstSpan, lineId);
+        history.insert(0, count - firstSpan, lineId);
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::overrun(const std::size_t lineId, const std::size_t position, const std::size_t count)
+    {
+        positions[lineId] = position;
+        changes().overrun(*this, lineId, position, count);
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::retain(const std::size_t newest, const std::size_t count)
+    {
+        retain(newest, count, std::integral_constant<bool, TimeBounded>());
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::retain(const std::size_t newest, const std::size_t count, std::true_type)
+    {
+        if(minimumAge_ == 0)
+        {
+            return;
+        }
+
+        for(std::size_t i = 1; (i <= count) && (i < history.size()); ++i)
+        {
+            if(retains(wrap(newest + i)))
+            {
+                if(!grow(newest))
+                {
+                    return;     // at capacity, overwritten by depth alone
+                }
+
+                i = 0;          // the slots following @newest moved up
+            }
+        }
+    }
+
+    template<class Traits>
+    bool ArbiterCache<Traits>::retains(const std::size_t position)
+    {
+        if(arrivals().since(position) >= minimumAge_)
+        {
+            return false;
+        }
+
+        if(!history[position].complete())
+        {
+            return true;
+        }
+
+        // a line still positioned here would be overrun.
+        for(const auto linePosition : positions)
+        {
+            if(linePosition == position)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template<class Traits>
+    bool ArbiterCache<Traits>::grow(const std::size_t newest)
+    {
+        const std::size_t depth = history.size();
+        if(depth == history.capacity())
+        {
+            return false;
+        }
+
+        const std::size_t grown = (history.capacity() - depth) < depth ? history.capacity() : 2 * depth;
+        const std::size_t growth = grown - depth;
+        const std::size_t oldest = newest + 1;
+
+        history.grow(grown, oldest);
+        arrivals().move(oldest, oldest + growth, depth - oldest);
+        shrinkDepth_ = 0;
+        changes().invalidate();
+
+        for(auto& position : positions)
+        {
+            position += (position >= oldest) ? growth : 0;
+        }
+
+        return true;
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::adapt(const std::size_t newest, const std::size_t count)
+    {
+        return adapt(newest, count, IsDynamic());
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::adapt(const std::size_t newest, const std::size_t count, std::true_type)
+    {
+        if(!adaptive_.enabled())
+        {
+            return 0;
+        }
+
+        // growing moves the slots following @newest, few of them near the history's end.
+        const std::size_t size = history.size();
+        const std::size_t lag = slowestLag(newest) + count;
+
+        if(adaptive_.crowded(lag, size) && ((lag >= size) || (size - 1 - newest <= ResizeStep)))
+        {
+            grow(newest);
+        }
+
+        if((shrinkDepth_ != 0) && adaptive_.crowded(lag, shrinkDepth_))
+        {
+            shrinkDepth_ = 0;
+        }
+
+        if(adaptive_.record(lag, count))
+        {
+            if(shrinkDepth_ != 0)
+            {
+                shrinkDepth_ = adaptive_.crowded(adaptive_.percentileLag(), shrinkDepth_) ? 0 : shrinkDepth_;
+            }
+            else
+            {
+                const std::size_t depth = history.size() / 2;
+                if((depth >= history.initialSize()) && !adaptive_.crowded(adaptive_.percentileLag(), depth) && !adaptive_.crowded(lag, depth))
+                {
+                    shrinkDepth_ = depth;
+                    dropNext_ = depth;
+                }
+            }
+        }
+
+        // head passes the shrinkDepth_ - 1 slots up to the end of those kept while at most
+        // shrinkDepth_ + 1 are dropped ahead of it.
+        dropBudget_ = 2 * (count + 1);
+        dropLimit_ = (shrinkDepth_ != 0) ? dropLimit(newest) : 0;
+
+        return shrinkDepth_;
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::dropping(const std::size_t newest)
+    {
+        return dropping(newest, IsDynamic());
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::dropping(const std::size_t newest, std::true_type)
+    {
+        if(shrinkDepth_ == 0)
+        {
+            return NoPosition;
+        }
+
+        const std::size_t size = history.size();
+        std::size_t position = dropNext_;
+
+        if(newest + 1 < shrinkDepth_)
+        {
+            if((dropBudget_ == 0) || (position >= dropLimit_))
+            {
+                return NoPosition;
+            }
+        }
+        else
+        {
+            const std::size_t folded = newest + 1 - shrinkDepth_;
+            if((dropNext_ < size) || (folded > ResizeStep) || (folded > shrinkDepth_))
+            {
+                dropNext_ = shrinkDepth_;
+                return NoPosition;
+            }
+
+            position = dropNext_ - size;
+            if(position == folded)
+            {
+                return NoPosition;      // all dropped, shrink() completes it
+            }
+        }
+
+        if((minimumAge_ != 0) && retains(position))
+        {
+            shrinkDepth_ = 0;
+            return NoPosition;
+        }
+
+        return position;
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::drop(const std::size_t position)
+    {
+        drop(position, IsDynamic());
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::drop(const std::size_t position, std::true_type)
+    {
+        history.retire(position);
+        changes().written(*this, position);
+
+        ++dropNext_;
+        dropBudget_ -= (dropBudget_ != 0) ? 1 : 0;
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::shrink(const std::size_t newest)
+    {
+        shrink(newest, IsDynamic());
+    }
+
+    template<class Traits>
+    void ArbiterCache<Traits>::shrink(const std::size_t newest, std::true_type)
+    {
+        const std::size_t depth = shrinkDepth_;
+        if((depth == 0) || (newest + 1 < depth) || (dropNext_ != history.size() + newest + 1 - depth))
+        {
+            return;
+        }
+
+        // the slots head wrote past the end of those kept.
+        const std::size_t folded = newest + 1 - depth;
+
+        history.shrink(depth, folded);
+        arrivals().move(depth, 0, folded);
+
+        for(auto& position : positions)
+        {
+            position -= (position >= depth) ? depth : 0;
+        }
+
+        shrinkDepth_ = 0;
+        overrunBudget_ = 0;
+        changes().invalidate();
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::dropLimit(const std::size_t newest) const
+    {
+        // a line past @newest has yet to arrive at the slots following its position.
+        std::size_t limit = history.size();
+        for(const auto position : positions)
+        {
+            if(position > newest)
+            {
+                const std::size_t following = (position + 1 > shrinkDepth_) ? position + 1 : shrinkDepth_;
+                limit = following < limit ? following : limit;
+            }
+        }
+
+        return limit;
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCache<Traits>::slowestLag(const std::size_t newest) const
+    {
+        std::size_t lag = 0;
+        for(const auto position : positions)
+        {
+            const std::size_t behind = wrap(newest + history.size() - position);
+            lag = behind > lag ? behind : lag;
+        }
+
+        return lag;
+    }
+
+    template<class Traits>
+    const HistoryConfig& ArbiterCache<Traits>::validate(const HistoryConfig& config)
+    {
+        if((config.minimumAge != 0) && !OptionalTraits<Traits>::ArrivalTimestamps())
+        {
+            throw InvalidHistoryConfig("a minimum age requires Traits::ArrivalTimestamps()");
+        }
+
+        return config;
     }
 }}
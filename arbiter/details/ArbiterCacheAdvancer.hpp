@@ -1,8 +1,11 @@
 #pragma once 
+#include <arbiter/AcceptedIntervals.hpp>
+#include <arbiter/AcceptedRange.hpp>
 #include <arbiter/details/ArbiterCache.hpp>
 #include <arbiter/details/ArbiterCacheAdvancerContext.hpp>
 #include <arbiter/details/ArbiterCacheAdvancerState.hpp>
 #include <arbiter/details/ArbiterCacheAdvancerStateEnum.hpp>
+#include <arbiter/details/BranchHints.hpp>
 #include <arbiter/details/states/ArbiterStatesPack.hpp>
 
 #include <array>
@@ -19,60 +22,225 @@ namespace arbiter { namespace details {
     public:
         using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
         using SequenceType = typename Traits::SequenceType;
+        using Sequence = SequenceArithmetic<Traits>;
 
         ArbiterCacheAdvancer(ArbiterCache<Traits>& cache, ErrorReportingPolicy& error);
+        explicit ArbiterCacheAdvancer(ArbiterCache<Traits>& cache);  // policy held by value, default constructed
 
-        // advance the cache position for @lineId up to @sequenceNumber
-        bool operator()(const std::size_t lineId, const SequenceType sequenceNumber);
+        ErrorReportingPolicy& errorPolicy() { return context_.errorPolicy(); }
 
-        // reset the state of the ArbiterCacheAdvancer
-        void reset();
+        // advance the cache position for @lineId up to @sequenceNumber. The next sequence
+        // number on a line (AdvanceHead / AdvanceLine) is handled inline, anything else
+        // goes through determineState() out of line.
+        inline bool operator()(const std::size_t lineId, const SequenceType sequenceNumber);
+
+        // advance the cache position for @lineId over @count sequence numbers received together,
+        // contiguous runs are handed to the states in one pass. Returns the number accepted.
+        std::size_t operator()(const std::size_t lineId, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept);
+
+        // advance the cache position for @lineId over the @count consecutive sequence numbers
+        // from @firstSequenceNumber (e.g. one packet), the whole range is a single run.
+        AcceptedRange<SequenceType> operator()(const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count);
+
+        // as above, writing each accepted sub-interval of the range to @intervals. Returns the number accepted.
+        template<std::size_t Capacity>
+        std::size_t operator()(const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, AcceptedIntervals<SequenceType, Capacity>& intervals);
 
     private:
+        static constexpr std::size_t RangeChunk = 64;     // accept flags kept on the stack per pass
+
+        // advance over the range, calling @accepted(offset, length) for each run of accepted
+        // sequence numbers in order. Adjacent runs may be reported separately.
+        template<class Accepted>
+        void advanceRange(const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, Accepted&& accepted);
+
+        ARBITER_NOINLINE bool advanceCold(const std::size_t lineId, const SequenceType sequenceNumber);
+
         ArbiterCacheAdvancerStateEnum determineState(const std::size_t lineId, const SequenceType sequenceNumber);
+        static std::size_t runLength(const SequenceType* sequenceNumbers, const std::size_t count);
 
     private:
         ArbiterStatesPack<Traits> states_;
         ArbiterCache<Traits>& cache_;
-        ErrorReportingPolicy& errorPolicy_;
-
-        bool isFirstCall_;
 
         ArbiterCacheAdvancerContext<Traits> context_;
     };
 
 
+    template<class Traits>
+    constexpr std::size_t ArbiterCacheAdvancer<Traits>::RangeChunk;
+
     template<class Traits>
     ArbiterCacheAdvancer<Traits>::ArbiterCacheAdvancer(ArbiterCache<Traits>& cache, ErrorReportingPolicy& error)
         : cache_(cache)
-        , errorPolicy_(error)
-        , isFirstCall_(true)
-        , context_(cache, error, isFirstCall_)
+        , context_(cache, error)
+    {
+    }
+
+    template<class Traits>
+    ArbiterCacheAdvancer<Traits>::ArbiterCacheAdvancer(ArbiterCache<Traits>& cache)
+        : cache_(cache)
+        , context_(cache)
     {
     }
 
     template<class Traits>
-    inline
     bool ArbiterCacheAdvancer<Traits>::operator()(const std::size_t lineId, const SequenceType sequenceNumber)
+    {
+        const auto linePosition = cache_.positions[lineId];
+        const bool isNext = Sequence::next(cache_.history[linePosition].sequence()) == sequenceNumber;
+
+        // head is NoHead until the first message is accepted, which sends it down the cold path.
+        if(ARBITER_LIKELY(isNext && (cache_.head != ArbiterCache<Traits>::NoHead)))
+        {
+            if(lineId == cache_.head)
+            {
+                return states_.advanceHead(context_, lineId, sequenceNumber);
+            }
+
+            if(linePosition != cache_.positions[cache_.head])
+            {
+                return states_.advanceLine(context_, lineId, sequenceNumber);
+            }
+
+            // we over take the current head, mark this line as head...
+            cache_.head = lineId;
+            return states_.advanceHead(context_, lineId, sequenceNumber);
+        }
+
+        return advanceCold(lineId, sequenceNumber);
+    }
+
+    template<class Traits>
+    bool ArbiterCacheAdvancer<Traits>::advanceCold(const std::size_t lineId, const SequenceType sequenceNumber)
     {
         return states_.advance(determineState(lineId, sequenceNumber), context_, lineId, sequenceNumber);
     }
 
     template<class Traits>
-    ArbiterCacheAdvancerStateEnum ArbiterCacheAdvancer<Traits>::determineState(const std::size_t lineId, const SequenceType sequenceNumber)
+    std::size_t ArbiterCacheAdvancer<Traits>::operator()(const std::size_t lineId, const SequenceType* sequenceNumbers, const std::size_t count, bool* accept)
     {
-        const auto linePosition = cache_.positions[lineId];
-        const auto currentSequenceNumber = cache_.history[linePosition].sequence();
+        std::size_t accepted = 0;
 
-        const bool isNext = currentSequenceNumber + 1 == sequenceNumber;
-        bool isHead = lineId == cache_.head;
+        for(std::size_t i = 0; i < count;)
+        {
+            const auto state = determineState(lineId, sequenceNumbers[i]);
+            const bool isRun = (state == ArbiterCacheAdvancerStateEnum::AdvanceHead) || (state == ArbiterCacheAdvancerStateEnum::AdvanceLine);
+
+            const auto run = isRun ? runLength(sequenceNumbers + i, count - i) : 1;
+            const auto consumed = states_.advance(state, context_, lineId, sequenceNumbers[i], run, accept + i);
+
+            for(std::size_t end = i + consumed; i < end; ++i)
+            {
+                accepted += accept[i] ? 1 : 0;
+            }
+        }
+
+        return accepted;
+    }
+
+    template<class Traits>
+    AcceptedRange<typename Traits::SequenceType> ArbiterCacheAdvancer<Traits>::operator()(const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count)
+    {
+        AcceptedRange<SequenceType> range{firstSequenceNumber, 0, 0};
+
+        std::size_t firstAccepted = count;
+        std::size_t lastAccepted = 0;
+
+        advanceRange(lineId, firstSequenceNumber, count, [&](const std::size_t offset, const std::size_t length)
+        {
+            firstAccepted = (firstAccepted == count) ? offset : firstAccepted;
+            lastAccepted = offset + length - 1;
+            range.accepted += length;
+        });
+
+        if(range.accepted != 0)
+        {
+            range.first = Sequence::advance(firstSequenceNumber, firstAccepted);
+            range.count = lastAccepted - firstAccepted + 1;
+        }
+
+        return range;
+    }
+
+    template<class Traits>
+    template<std::size_t Capacity>
+    std::size_t ArbiterCacheAdvancer<Traits>::operator()(const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, AcceptedIntervals<SequenceType, Capacity>& intervals)
+    {
+        intervals.clear();
+
+        advanceRange(lineId, firstSequenceNumber, count, [&](const std::size_t offset, const std::size_t length)
+        {
+            intervals.append(Sequence::advance(firstSequenceNumber, offset), length);
+        });
+
+        return intervals.accepted();
+    }
+
+    template<class Traits>
+    template<class Accepted>
+    void ArbiterCacheAdvancer<Traits>::advanceRange(const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, Accepted&& accepted)
+    {
+        bool accept[RangeChunk];
+
+        for(std::size_t chunk = 0; chunk < count; chunk += RangeChunk)
+        {
+            const std::size_t chunkSize = (count - chunk) < RangeChunk ? (count - chunk) : RangeChunk;
+
+            for(std::size_t i = 0; i < chunkSize;)
+            {
+                const auto sequenceNumber = Sequence::advance(firstSequenceNumber, chunk + i);
+                const auto state = determineState(lineId, sequenceNumber);
+                const bool isRun = (state == ArbiterCacheAdvancerStateEnum::AdvanceHead) || (state == ArbiterCacheAdvancerStateEnum::AdvanceLine);
+
+                const auto end = i + states_.advance(state, context_, lineId, sequenceNumber, isRun ? chunkSize - i : 1, accept + i);
+
+                while(i < end)
+                {
+                    if(!accept[i])
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    const auto start = i;
+                    while((i < end) && accept[i])
+                    {
+                        ++i;
+                    }
 
-        if(isFirstCall_)
+                    accepted(chunk + start, i - start);
+                }
+            }
+        }
+    }
+
+    template<class Traits>
+    std::size_t ArbiterCacheAdvancer<Traits>::runLength(const SequenceType* sequenceNumbers, const std::size_t count)
+    {
+        std::size_t length = 1;
+        while((length < count) && (Sequence::next(sequenceNumbers[length - 1]) == sequenceNumbers[length]))
+        {
+            ++length;
+        }
+
+        return length;
+    }
+
+    template<class Traits>
+    ArbiterCacheAdvancerStateEnum ArbiterCacheAdvancer<Traits>::determineState(const std::size_t lineId, const SequenceType sequenceNumber)
+    {
+        if(cache_.head == ArbiterCache<Traits>::NoHead)
         {
-            isFirstCall_ = false;
             return ArbiterCacheAdvancerStateEnum::InitialState;
         }
 
+        const auto linePosition = cache_.positions[lineId];
+        const auto currentSequenceNumber = cache_.history[linePosition].sequence();
+
+        const bool isNext = Sequence::next(currentSequenceNumber) == sequenceNumber;
+        bool isHead = lineId == cache_.head;
+
         if(isNext)
         {
             // if we over take the current head, mark this line as head...
@@ -87,7 +255,7 @@ namespace arbiter { namespace details {
                 ArbiterCacheAdvancerStateEnum::AdvanceLine;
         }
 
-        if(sequenceNumber <= currentSequenceNumber)
+        if(Sequence::precedesOrEqual(sequenceNumber, currentSequenceNumber))
         {
             return ArbiterCacheAdvancerStateEnum::GapFill;
         }
@@ -96,10 +264,4 @@ namespace arbiter { namespace details {
             ArbiterCacheAdvancerStateEnum::HeadForwardGapFill :
             ArbiterCacheAdvancerStateEnum::LineForwardGapFill;
     }
-
-    template<class Traits>
-    void ArbiterCacheAdvancer<Traits>::reset()
-    {
-        isFirstCall_ = true;
-    }
 }}
@@ -1,23 +1,108 @@
 #pragma once 
 #include <arbiter/details/ArbiterCache.hpp>
+#include <arbiter/details/ErrorPolicyHolder.hpp>
+#include <arbiter/details/ErrorReportingPolicyTraits.hpp>
+#include <arbiter/details/OptionalTraits.hpp>
+#include <arbiter/details/SequenceArithmetic.hpp>
 
 namespace arbiter { namespace details {
 
     // A context object to hold cache & error policy...
+    // The policy holder is a base, so a stateless policy held by value takes no space.
     template<class Traits>
     struct ArbiterCacheAdvancerContext
+        : private ErrorPolicyHolder<typename Traits::ErrorReportingPolicy, OptionalTraits<Traits>::ErrorReportingPolicyByValue()>
     {
         using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
+        using PolicyHolder = ErrorPolicyHolder<ErrorReportingPolicy, OptionalTraits<Traits>::ErrorReportingPolicyByValue()>;
+        using SequenceType = typename Traits::SequenceType;
+        using PolicyTraits = ErrorReportingPolicyTraits<ErrorReportingPolicy, typename ArbiterCache<Traits>::SeqInfo::LineSet, SequenceType>;
 
-        ArbiterCacheAdvancerContext(ArbiterCache<Traits>& cacheIn, ErrorReportingPolicy& errorPolicyIn, bool& isFirstCallIn)
-            : cache(cacheIn)
-            , errorPolicy(errorPolicyIn)
-            , isFirstCall(isFirstCallIn)
+        ArbiterCacheAdvancerContext(ArbiterCache<Traits>& cacheIn, ErrorReportingPolicy& errorPolicyIn)
+            : PolicyHolder(errorPolicyIn)
+            , cache(cacheIn)
         {
         }
 
+        // default constructs a policy held by value.
+        explicit ArbiterCacheAdvancerContext(ArbiterCache<Traits>& cacheIn)
+            : PolicyHolder()
+            , cache(cacheIn)
+        {
+        }
+
+        ErrorReportingPolicy& errorPolicy() { return PolicyHolder::get(); }
+
+        // GapFill() of a single @sequenceNumber, with GapFillLatency() when the policy defines it.
+        inline void reportGapFill(const SequenceType sequenceNumber);
+
+        // @lineId delivered @sequenceNumber, now at history @position, first.
+        inline void reportFirstArrival(const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position);
+
+        // @lineId delivered the expected copy of @sequenceNumber at history @position, another line was first.
+        inline void reportLateArrival(const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position);
+
+        // true when a late arrival needs the slot checked, to tell it from a duplicate.
+        static constexpr bool ReportsLateArrival() { return PolicyTraits::HasLateArrival::value; }
+
         ArbiterCache<Traits>& cache;
-        ErrorReportingPolicy& errorPolicy;
-        bool& isFirstCall;
+
+    private:
+        inline SequenceType behindHead(const SequenceType sequenceNumber);
+
+        inline void reportGapFillLatency(const SequenceType sequenceNumber, std::true_type);
+        inline void reportGapFillLatency(const SequenceType, std::false_type) {}
+
+        inline void reportFirstArrival(const std::size_t lineId, const SequenceType sequenceNumber, std::true_type);
+        inline void reportFirstArrival(const std::size_t, const SequenceType, std::false_type) {}
+
+        inline void reportLateArrival(const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position, std::true_type);
+        inline void reportLateArrival(const std::size_t, const SequenceType, const std::size_t, std::false_type) {}
     };
+
+
+    template<class Traits>
+    void ArbiterCacheAdvancerContext<Traits>::reportGapFill(const SequenceType sequenceNumber)
+    {
+        errorPolicy().GapFill(sequenceNumber, 1);
+        reportGapFillLatency(sequenceNumber, typename PolicyTraits::HasGapFillLatency());
+    }
+
+    template<class Traits>
+    void ArbiterCacheAdvancerContext<Traits>::reportFirstArrival(const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position)
+    {
+        cache.arrivals().record(position);
+        reportFirstArrival(lineId, sequenceNumber, typename PolicyTraits::HasFirstArrival());
+    }
+
+    template<class Traits>
+    void ArbiterCacheAdvancerContext<Traits>::reportLateArrival(const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position)
+    {
+        reportLateArrival(lineId, sequenceNumber, position, typename PolicyTraits::HasLateArrival());
+    }
+
+    template<class Traits>
+    typename ArbiterCacheAdvancerContext<Traits>::SequenceType ArbiterCacheAdvancerContext<Traits>::behindHead(const SequenceType sequenceNumber)
+    {
+        const SequenceType headSequenceNumber = cache.history[cache.positions[cache.head]].sequence();
+        return static_cast<SequenceType>(headSequenceNumber - sequenceNumber);
+    }
+
+    template<class Traits>
+    void ArbiterCacheAdvancerContext<Traits>::reportGapFillLatency(const SequenceType sequenceNumber, std::true_type)
+    {
+        errorPolicy().GapFillLatency(sequenceNumber, behindHead(sequenceNumber));
+    }
+
+    template<class Traits>
+    void ArbiterCacheAdvancerContext<Traits>::reportFirstArrival(const std::size_t lineId, const SequenceType sequenceNumber, std::true_type)
+    {
+        errorPolicy().FirstArrival(lineId, sequenceNumber);
+    }
+
+    template<class Traits>
+    void ArbiterCacheAdvancerContext<Traits>::reportLateArrival(const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position, std::true_type)
+    {
+        errorPolicy().LateArrival(lineId, sequenceNumber, behindHead(sequenceNumber), cache.arrivals().since(position));
+    }
 }}
@@ -0,0 +1,325 @@
+#pragma once
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/details/ArbiterCache.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace arbiter { namespace details {
+
+    // Binary image of an ArbiterCache in 64 bit words: a header, the line positions and one
+    // fixed size record (sequence number, line mask words) per history slot. write() stores only
+    // the records which differ. With Traits::IncrementalSnapshots() it also encodes only the slots
+    // the cache wrote since its last write() to the same buffer, so checkpointing into one buffer
+    // (e.g. shared memory) costs the slots changed since the last checkpoint rather than the
+    // history depth.
+    // The header's generation is odd while a snapshot is being written. As in the seqlock of
+    // StatsErrorReportingPolicy, the image is written and read as relaxed atomic words, and
+    // read() copies it before checking the generation again. It refuses an odd generation, or
+    // one which changed while it copied the image.
+    // Arrival timestamps are clock ticks of the writing host and aren't part of the image.
+    // The image has room for a time bounded history grown to capacity, size() doesn't change.
+    template<class Traits>
+    class ArbiterSnapshot
+    {
+    public:
+        using SequenceType = typename Traits::SequenceType;
+        using Cache = ArbiterCache<Traits>;
+        using SeqInfo = typename Cache::SeqInfo;
+
+        // bytes of the image of @cache.
+        static std::size_t size(const Cache& cache);
+
+        // write @cache to @buffer (size(cache) bytes, 8 byte aligned). Returns the number of history slots written.
+        static std::size_t write(Cache& cache, void* buffer);
+
+        // restore @cache from @buffer, throws InvalidSnapshot and leaves @cache as it was if
+        // @buffer doesn't hold a complete, valid image. The caller may read again.
+        static void read(Cache& cache, const void* buffer);
+
+    private:
+        using Word = std::atomic<std::uint64_t>;
+        static_assert(sizeof(Word) == sizeof(std::uint64_t), "snapshot words must be plain 64 bit words.");
+
+        static constexpr std::uint32_t Magic = 0x41524231;     // "ARB1"
+        static constexpr std::size_t Words = (Traits::NumberOfLines() + 63) / 64;
+        static constexpr std::size_t RecordWords = 1 + Words;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t sequenceBytes;
+            std::uint64_t generation;
+            std::uint64_t numberOfLines;
+            std::uint64_t historyDepth;     // capacity
+            std::uint64_t depth;            // slots in use
+            std::uint64_t head;
+        };
+
+        static constexpr std::size_t HeaderWords = sizeof(Header) / sizeof(std::uint64_t);
+        static constexpr std::size_t GenerationWord = offsetof(Header, generation) / sizeof(std::uint64_t);
+
+        static std::size_t depth(const Cache& cache) { return cache.history.size(); }
+        static std::size_t capacity(const Cache& cache) { return cache.capacity(); }
+        static std::size_t lines(const Cache& cache) { return cache.positions.size(); }
+
+        static bool matches(const Header& header, const Cache& cache);
+
+        static Word* words(void* buffer) { return static_cast<Word*>(buffer); }
+        static const Word* words(const void* buffer) { return static_cast<const Word*>(buffer); }
+
+        // the header but its generation.
+        static Header loadHeader(const void* buffer);
+        static void storeHeader(void* buffer, const Header& header);
+
+        static std::size_t recordsOffset(const Cache& cache) { return HeaderWords + lines(cache); }
+
+        template<class Slot>
+        static void encode(Slot&& slot, std::uint64_t* record);
+        static SeqInfo decode(const std::uint64_t* record);
+    };
+
+
+    template<class Traits>
+    constexpr std::uint32_t ArbiterSnapshot<Traits>::Magic;
+
+    template<class Traits>
+    constexpr std::size_t ArbiterSnapshot<Traits>::Words;
+
+    template<class Traits>
+    constexpr std::size_t ArbiterSnapshot<Traits>::RecordWords;
+
+    template<class Traits>
+    constexpr std::size_t ArbiterSnapshot<Traits>::HeaderWords;
+
+    template<class Traits>
+    constexpr std::size_t ArbiterSnapshot<Traits>::GenerationWord;
+
+    template<class Traits>
+    std::size_t ArbiterSnapshot<Traits>::size(const Cache& cache)
+    {
+        return (recordsOffset(cache) + capacity(cache) * RecordWords) * sizeof(std::uint64_t);
+    }
+
+    template<class Traits>
+    std::size_t ArbiterSnapshot<Traits>::write(Cache& cache, void* buffer)
+    {
+        auto image = words(buffer);
+
+        // the only writer, the generation is read back as it was stored.
+        auto header = loadHeader(buffer);
+        header.generation = image[GenerationWord].load(std::memory_order_relaxed);
+
+        // an image of another arbiter (or an uninitialized buffer) is overwritten in full, as is
+        // one of a history since grown, its slots have moved.
+        const bool full = !matches(header, cache) || (header.depth != depth(cache));
+        if(full)
+        {
+            header = Header{Magic, sizeof(SequenceType), header.generation & ~std::uint64_t(1), lines(cache), capacity(cache), depth(cache), 0};
+        }
+
+        // with IncrementalSnapshots() the cache tracks the slots changed since the image it last
+        // wrote, oldest first ending with head's. Otherwise every slot is compared.
+        const std::size_t changed = full ? depth(cache) : cache.changes().unsnapshotted(cache, buffer, header.generation);
+
+        ++header.generation;   // odd, writing
+        image[GenerationWord].store(header.generation, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for(std::size_t lineId = 0; lineId < lines(cache); ++lineId)
+        {
+            image[HeaderWords + lineId].store(cache.positions[lineId], std::memory_order_relaxed);
+        }
+
+        std::size_t position = (changed == depth(cache)) ? 0 : cache.wrap(cache.positions[cache.head] + depth(cache) + 1 - changed);
+
+        std::size_t written = 0;
+        std::uint64_t record[RecordWords];
+        auto slots = image + recordsOffset(cache);
+
+        for(std::size_t i = 0; i < changed; ++i)
+        {
+            encode(cache.history[position], record);
+
+            auto stored = slots + position * RecordWords;
+            bool differs = full;
+
+            for(std::size_t word = 0; !differs && (word < RecordWords); ++word)
+            {
+                differs = stored[word].load(std::memory_order_relaxed) != record[word];
+            }
+
+            for(std::size_t word = 0; differs && (word < RecordWords); ++word)
+            {
+                stored[word].store(record[word], std::memory_order_relaxed);
+            }
+
+            written += differs ? 1 : 0;
+            position = (position + 1 == depth(cache)) ? 0 : position + 1;
+        }
+
+        header.head = cache.head;
+        storeHeader(buffer, header);
+
+        ++header.generation;   // even, complete
+        image[GenerationWord].store(header.generation, std::memory_order_release);
+
+        cache.changes().snapshotted(cache, buffer, header.generation);
+        return written;
+    }
+
+    template<class Traits>
+    void ArbiterSnapshot<Traits>::read(Cache& cache, const void* buffer)
+    {
+        if((reinterpret_cast<std::uintptr_t>(buffer) % alignof(Word)) != 0)
+        {
+            throw InvalidSnapshot("not aligned to 8 bytes");
+        }
+
+        auto image = words(buffer);
+        const auto generation = image[GenerationWord].load(std::memory_order_acquire);
+
+        auto header = loadHeader(buffer);
+        header.generation = generation;
+
+        if(header.magic != Magic)
+        {
+            throw InvalidSnapshot("not an arbiter snapshot");
+        }
+
+        if(!matches(header, cache))
+        {
+            throw InvalidSnapshot("written by an arbiter with different sequence type, lines or history depth");
+        }
+
+        if((generation & 1) != 0)
+        {
+            throw InvalidSnapshot("incomplete, the writer stopped part way through");
+        }
+
+        if((header.depth == 0) || (header.depth > capacity(cache)))
+        {
+            throw InvalidSnapshot("history depth is out of range");
+        }
+
+        // copied, then checked and decoded once the generation shows the copy is of one image.
+        std::vector<std::uint64_t> copy(recordsOffset(cache) + static_cast<std::size_t>(header.depth) * RecordWords);
+        for(std::size_t word = HeaderWords; word < copy.size(); ++word)
+        {
+            copy[word] = image[word].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(image[GenerationWord].load(std::memory_order_relaxed) != generation)
+        {
+            throw InvalidSnapshot("overwritten while being read");
+        }
+
+        if((header.head != Cache::NoHead) && (header.head >= lines(cache)))
+        {
+            throw InvalidSnapshot("head is out of range");
+        }
+
+        for(std::size_t lineId = 0; lineId < lines(cache); ++lineId)
+        {
+            if(copy[HeaderWords + lineId] >= header.depth)
+            {
+                throw InvalidSnapshot("line position is out of range");
+            }
+        }
+
+        cache.reset(static_cast<std::size_t>(header.depth));
+
+        for(std::size_t lineId = 0; lineId < lines(cache); ++lineId)
+        {
+            cache.positions[lineId] = static_cast<std::size_t>(copy[HeaderWords + lineId]);
+        }
+
+        cache.head = static_cast<std::size_t>(header.head);
+        if(cache.head != Cache::NoHead)
+        {
+            // oldest slot first, ending with head's, so implicit sequence histories rebuild their segments in order.
+            auto slots = copy.data() + recordsOffset(cache);
+            const auto newest = cache.positions[cache.head];
+
+            for(std::size_t i = 1; i <= depth(cache); ++i)
+            {
+                const auto position = cache.wrap(newest + i);
+                cache.history[position] = decode(slots + position * RecordWords);
+            }
+        }
+    }
+
+    template<class Traits>
+    bool ArbiterSnapshot<Traits>::matches(const Header& header, const Cache& cache)
+    {
+        return (header.magic == Magic) &&
+               (header.sequenceBytes == sizeof(SequenceType)) &&
+               (header.numberOfLines == lines(cache)) &&
+               (header.historyDepth == capacity(cache));
+    }
+
+    template<class Traits>
+    typename ArbiterSnapshot<Traits>::Header ArbiterSnapshot<Traits>::loadHeader(const void* buffer)
+    {
+        std::uint64_t raw[HeaderWords];
+        for(std::size_t word = 0; word < HeaderWords; ++word)
+        {
+            raw[word] = (word != GenerationWord) ? words(buffer)[word].load(std::memory_order_relaxed) : 0;
+        }
+
+        Header header;
+        std::memcpy(&header, raw, sizeof(Header));
+        return header;
+    }
+
+    template<class Traits>
+    void ArbiterSnapshot<Traits>::storeHeader(void* buffer, const Header& header)
+    {
+        std::uint64_t raw[HeaderWords];
+        std::memcpy(raw, &header, sizeof(Header));
+
+        for(std::size_t word = 0; word < HeaderWords; ++word)
+        {
+            if(word != GenerationWord)
+            {
+                words(buffer)[word].store(raw[word], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<class Traits>
+    template<class Slot>
+    void ArbiterSnapshot<Traits>::encode(Slot&& slot, std::uint64_t* record)
+    {
+        record[0] = static_cast<std::uint64_t>(slot.sequence());
+
+        const auto lineSet = slot.lines();
+        for(std::size_t i = 0; i < Words; ++i)
+        {
+            record[1 + i] = lineSet.word(i);
+        }
+    }
+
+    template<class Traits>
+    typename ArbiterSnapshot<Traits>::SeqInfo ArbiterSnapshot<Traits>::decode(const std::uint64_t* record)
+    {
+        SeqInfo info(static_cast<SequenceType>(record[0]));
+        for(std::size_t i = 0; i < Words; ++i)
+        {
+            const auto word = record[1 + i];
+            for(std::size_t bit = 0; (bit < 64) && (i * 64 + bit < Traits::NumberOfLines()); ++bit)
+            {
+                if(((word >> bit) & 1) != 0)
+                {
+                    info.insert(i * 64 + bit);
+                }
+            }
+        }
+
+        return info;
+    }
+}}
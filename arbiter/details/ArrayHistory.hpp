@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace arbiter { namespace details {
+
+    // The default history storage, a fixed size array of SequenceInfo.
+    template<class SeqInfo, std::size_t HistoryDepth>
+    class ArrayHistory
+    {
+    public:
+        inline SeqInfo& operator[](const std::size_t position);
+        inline const SeqInfo& operator[](const std::size_t position) const;
+
+        static constexpr std::size_t size() { return HistoryDepth; }
+
+        // write gap slots SeqInfo(@firstSequence), SeqInfo(@firstSequence + 1), ...
+        // to the contiguous span [@position, @position + @count), no wrapping.
+        template<typename SequenceType>
+        void fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count);
+
+        // add @lineId to every slot of the contiguous span [@position, @position + @count), no wrapping.
+        void insert(const std::size_t position, const std::size_t count, const std::size_t lineId);
+
+        // return every slot to SeqInfo(), O(HistoryDepth)
+        void reset();
+
+    private:
+        std::array<SeqInfo, HistoryDepth> history_;
+    };
+
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    SeqInfo& ArrayHistory<SeqInfo, HistoryDepth>::operator[](const std::size_t position)
+    {
+        return history_[position];
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    const SeqInfo& ArrayHistory<SeqInfo, HistoryDepth>::operator[](const std::size_t position) const
+    {
+        return history_[position];
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    template<typename SequenceType>
+    void ArrayHistory<SeqInfo, HistoryDepth>::fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count)
+    {
+        SeqInfo* slots = history_.data() + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            slots[i] = SeqInfo(static_cast<SequenceType>(firstSequence + i));
+        }
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    void ArrayHistory<SeqInfo, HistoryDepth>::insert(const std::size_t position, const std::size_t count, const std::size_t lineId)
+    {
+        SeqInfo* slots = history_.data() + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            slots[i].insert(lineId);
+        }
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    void ArrayHistory<SeqInfo, HistoryDepth>::reset()
+    {
+        for(auto& historyValue : history_)
+        {
+            historyValue = SeqInfo();
+        }
+    }
+}}
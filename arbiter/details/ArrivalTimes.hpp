@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace arbiter { namespace details {
+
+    // The timestamp of the first arrival of each sequence in history, indexed
+    // by history position, so the lag of later copies can be measured in the
+    // caller's clock (e.g. TSC ticks). A gap slot holds when the gap opened
+    // until it's filled. Disabled it's empty and does nothing.
+    template<bool Enabled>
+    class ArrivalTimes;
+
+    template<>
+    class ArrivalTimes<false>
+    {
+    public:
+        explicit ArrivalTimes(const std::size_t /*historySize*/) {}
+
+        void now(const std::uint64_t /*timestamp*/) {}
+        void record(const std::size_t /*position*/) {}
+        void record(const std::size_t /*position*/, const std::size_t /*count*/) {}
+        void move(const std::size_t /*from*/, const std::size_t /*to*/, const std::size_t /*count*/) {}
+        std::uint64_t since(const std::size_t /*position*/) const { return 0; }
+    };
+
+    template<>
+    class ArrivalTimes<true>
+    {
+    public:
+        explicit ArrivalTimes(const std::size_t historySize)
+            : times_(new std::uint64_t[historySize]())
+            , now_(0)
+        {
+        }
+
+        // the arrival time of the message being validated.
+        void now(const std::uint64_t timestamp) { now_ = timestamp; }
+
+        // the message being validated is the first arrival of the sequence at @position.
+        void record(const std::size_t position) { times_[position] = now_; }
+
+        // the message being validated opened a gap over [@position, @position + @count).
+        void record(const std::size_t position, const std::size_t count) { std::fill(times_.get() + position, times_.get() + position + count, now_); }
+
+        // the history moved the @count slots from @from to @to.
+        void move(const std::size_t from, const std::size_t to, const std::size_t count) { std::memmove(times_.get() + to, times_.get() + from, count * sizeof(std::uint64_t)); }
+
+        // time since the first arrival of the sequence at @position.
+        std::uint64_t since(const std::size_t position) const { return now_ - times_[position]; }
+
+    private:
+        std::unique_ptr<std::uint64_t[]> times_;
+        std::uint64_t now_;
+    };
+}}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace arbiter { namespace details {
+
+    constexpr bool isPowerOfTwo(const std::size_t value)
+    {
+        return (value != 0) && ((value & (value - 1)) == 0);
+    }
+
+    // index of the lowest set bit, @value must not be 0.
+    inline unsigned countTrailingZeros(const std::uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+    }
+
+    // number of bits needed to represent @value, 0 for 0.
+    inline unsigned bitWidth(const std::uint64_t value)
+    {
+        if(value == 0)
+        {
+            return 0;
+        }
+
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<unsigned>(index) + 1;
+#else
+        return 64 - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+    }
+
+    inline unsigned populationCount(const std::uint64_t value)
+    {
+#ifdef _MSC_VER
+        return static_cast<unsigned>(__popcnt64(value));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(value));
+#endif
+    }
+
+    // call @function(index) for each set bit in @word, lowest first.
+    template<class Function>
+    inline void forEachSetBit(std::uint64_t word, const std::size_t offset, Function&& function)
+    {
+        while(word != 0)
+        {
+            function(offset + countTrailingZeros(word));
+            word &= word - 1;   // clear the lowest set bit
+        }
+    }
+}}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Layout hints for the per-message hot path. ARBITER_LIKELY / ARBITER_UNLIKELY
+// keep the expected branch on the fall through path, ARBITER_NOINLINE keeps
+// rarely taken code out of line so it doesn't bloat its caller.
+// ARBITER_UNREACHABLE() marks code no input reaches, e.g. the end of a switch
+// covering every value, so the compiler emits nothing for it.
+#if defined(__GNUC__) || defined(__clang__)
+    #define ARBITER_LIKELY(condition) __builtin_expect(!!(condition), 1)
+    #define ARBITER_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+    #define ARBITER_NOINLINE __attribute__((noinline))
+    #define ARBITER_UNREACHABLE() __builtin_unreachable()
+#elif defined(_MSC_VER)
+    #define ARBITER_LIKELY(condition) (condition)
+    #define ARBITER_UNLIKELY(condition) (condition)
+    #define ARBITER_NOINLINE __declspec(noinline)
+    #define ARBITER_UNREACHABLE() __assume(0)
+#else
+    #include <cstdlib>
+
+    #define ARBITER_LIKELY(condition) (condition)
+    #define ARBITER_UNLIKELY(condition) (condition)
+    #define ARBITER_NOINLINE
+    #define ARBITER_UNREACHABLE() std::abort()
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter { namespace details {
+
+    // The history slots which changed since the last snapshot into a buffer, so the next
+    // snapshot into it encodes only those. Slots are numbered by head's writes, never
+    // wrapping. @Cache is the ArbiterCache reporting head's writes, lines added to slots
+    // behind head and lines moved by an overrun. Disabled it's empty and does nothing,
+    // every snapshot then encodes the whole history.
+    template<bool Enabled, std::size_t Lines>
+    class ChangedSlots;
+
+    template<std::size_t Lines>
+    class ChangedSlots<false, Lines>
+    {
+    public:
+        void advanced(const std::size_t /*count*/) {}
+        template<class Cache> void written(const Cache& /*cache*/, const std::size_t /*position*/) {}
+        template<class Cache> void overrun(const Cache& /*cache*/, const std::size_t /*lineId*/, const std::size_t /*position*/, const std::size_t /*count*/) {}
+        void invalidate() {}
+
+        template<class Cache> std::size_t unsnapshotted(const Cache& cache, const void* /*buffer*/, const std::uint64_t /*generation*/) const { return cache.history.size(); }
+        template<class Cache> void snapshotted(const Cache& /*cache*/, const void* /*buffer*/, const std::uint64_t /*generation*/) {}
+    };
+
+    template<std::size_t Lines>
+    class ChangedSlots<true, Lines>
+    {
+    public:
+        ChangedSlots()
+            : headSlot_(0)
+            , snapshotHead_(0)
+            , snapshotLines_()
+            , changedSince_(0)
+            , buffer_(nullptr)
+            , generation_(0)
+        {
+        }
+
+        // head wrote the @count slots following its own.
+        void advanced(const std::size_t count) { headSlot_ += count; }
+
+        // the slot at @position changed behind head: a line was added to it (a gap fill) or a shrink dropped it.
+        template<class Cache> void written(const Cache& cache, const std::size_t position);
+
+        // @lineId, overrun by head writing the @count slots following its own, moves to @position.
+        template<class Cache> void overrun(const Cache& cache, const std::size_t lineId, const std::size_t position, const std::size_t count);
+
+        // the history was reset or resized, the next snapshot is written in full.
+        void invalidate() { buffer_ = nullptr; }
+
+        // the slots, ending with head's, which may differ from the image at @generation in @buffer:
+        // all of them unless snapshotted() was last called with both, the history hasn't been
+        // reset or resized since and head has started.
+        template<class Cache> std::size_t unsnapshotted(const Cache& cache, const void* buffer, const std::uint64_t generation) const;
+        template<class Cache> void snapshotted(const Cache& cache, const void* buffer, const std::uint64_t generation);
+
+    private:
+        template<class Cache> std::size_t behindHead(const Cache& cache, const std::size_t position) const;
+        template<class Cache> std::uint64_t slotOf(const Cache& cache, const std::size_t position) const;
+
+        // head's slot. As of the last snapshot: head's and each line's slot, and the oldest
+        // slot since written behind a line's position.
+        std::uint64_t headSlot_;
+        std::uint64_t snapshotHead_;
+        std::array<std::uint64_t, Lines> snapshotLines_;
+        std::uint64_t changedSince_;
+
+        const void* buffer_;    // nullptr once reset or resized, the next snapshot is written in full
+        std::uint64_t generation_;
+    };
+
+
+    template<std::size_t Lines>
+    template<class Cache>
+    void ChangedSlots<true, Lines>::written(const Cache& cache, const std::size_t position)
+    {
+        // a slot further behind than head has written (since a grow opened slots) is only in a full image.
+        const std::size_t behind = behindHead(cache, position);
+        if(behind > headSlot_)
+        {
+            buffer_ = nullptr;
+            return;
+        }
+
+        const std::uint64_t slot = headSlot_ - behind;
+        changedSince_ = slot < changedSince_ ? slot : changedSince_;
+    }
+
+    template<std::size_t Lines>
+    template<class Cache>
+    void ChangedSlots<true, Lines>::overrun(const Cache& cache, const std::size_t lineId, const std::size_t position, const std::size_t count)
+    {
+        // the slots the line wrote are at or behind its position, head overwrites them. Its new
+        // slot is numbered as head will have written it, when among the @count slots.
+        const std::size_t ahead = cache.wrap(position + cache.history.size() - cache.positions[cache.head]);
+        snapshotLines_[lineId] = ((ahead != 0) && (ahead <= count)) ? headSlot_ + ahead : slotOf(cache, position);
+    }
+
+    template<std::size_t Lines>
+    template<class Cache>
+    std::size_t ChangedSlots<true, Lines>::unsnapshotted(const Cache& cache, const void* buffer, const std::uint64_t generation) const
+    {
+        if((buffer != buffer_) || (generation != generation_) || (cache.head == Cache::NoHead))
+        {
+            return cache.history.size();
+        }
+
+        // head's slots since, a line's past the one it was in, and those written behind.
+        std::uint64_t oldest = snapshotHead_ + 1;
+        oldest = changedSince_ < oldest ? changedSince_ : oldest;
+
+        for(std::size_t lineId = 0; lineId < cache.positions.size(); ++lineId)
+        {
+            if(slotOf(cache, cache.positions[lineId]) != snapshotLines_[lineId])
+            {
+                const auto slot = snapshotLines_[lineId] + 1;
+                oldest = slot < oldest ? slot : oldest;
+            }
+        }
+
+        const std::uint64_t changed = headSlot_ + 1 - oldest;
+        return changed < cache.history.size() ? static_cast<std::size_t>(changed) : cache.history.size();
+    }
+
+    template<std::size_t Lines>
+    template<class Cache>
+    void ChangedSlots<true, Lines>::snapshotted(const Cache& cache, const void* buffer, const std::uint64_t generation)
+    {
+        const bool started = cache.head != Cache::NoHead;
+
+        buffer_ = started ? buffer : nullptr;
+        generation_ = generation;
+        snapshotHead_ = headSlot_;
+        changedSince_ = headSlot_ + 1;
+
+        for(std::size_t lineId = 0; started && (lineId < cache.positions.size()); ++lineId)
+        {
+            snapshotLines_[lineId] = slotOf(cache, cache.positions[lineId]);
+        }
+    }
+
+    template<std::size_t Lines>
+    template<class Cache>
+    std::size_t ChangedSlots<true, Lines>::behindHead(const Cache& cache, const std::size_t position) const
+    {
+        return cache.wrap(cache.positions[cache.head] + cache.history.size() - position);
+    }
+
+    template<std::size_t Lines>
+    template<class Cache>
+    std::uint64_t ChangedSlots<true, Lines>::slotOf(const Cache& cache, const std::size_t position) const
+    {
+        return headSlot_ - behindHead(cache, position);
+    }
+}}
@@ -0,0 +1,177 @@
+#pragma once
+#include <arbiter/details/LineMask.hpp>
+#include <arbiter/details/SequenceInfo.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace arbiter { namespace details {
+
+    // Structure of arrays history storage. Sequence numbers and packed
+    // line masks are kept in separate dense arrays, so scans of one
+    // don't pull the other into cache. operator[] returns a Slot
+    // referencing both, with the same interface as SequenceInfo.
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    class ColumnHistory
+    {
+    public:
+        using SeqInfo = SequenceInfo<SequenceType, NumberOfLines>;
+        using LineSet = typename SeqInfo::LineSet;
+        using Mask = typename LineMaskType<NumberOfLines>::type;
+
+        static constexpr Mask AllLines = LineMaskType<NumberOfLines>::AllLines;
+
+        class Slot
+        {
+        public:
+            Slot(SequenceType& sequence, Mask& lines);
+
+            inline Slot& operator=(const SeqInfo& info);
+
+            inline void insert(const std::size_t lineId);
+            inline bool has(const std::size_t lineId) const;
+
+            inline bool complete() const;
+            inline bool empty() const;
+
+            inline LineSet lines() const;
+
+            inline SequenceType sequence() const;
+            inline void sequence(const SequenceType seq);
+
+        private:
+            SequenceType& sequence_;
+            Mask& lines_;
+        };
+
+        ColumnHistory();
+
+        inline Slot operator[](const std::size_t position);
+
+        static constexpr std::size_t size() { return HistoryDepth; }
+
+        // write gap slots SeqInfo(@firstSequence), SeqInfo(@firstSequence + 1), ...
+        // to the contiguous span [@position, @position + @count), no wrapping.
+        void fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count);
+
+        // add @lineId to every slot of the contiguous span [@position, @position + @count), no wrapping.
+        void insert(const std::size_t position, const std::size_t count, const std::size_t lineId);
+
+        // return every slot to SeqInfo(), O(HistoryDepth)
+        void reset();
+
+    private:
+        std::array<SequenceType, HistoryDepth> sequences_;
+        std::array<Mask, HistoryDepth> lines_;
+    };
+
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    constexpr typename ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Mask ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::AllLines;
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::Slot(SequenceType& sequence, Mask& lines)
+        : sequence_(sequence)
+        , lines_(lines)
+    {
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    typename ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot& ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::operator=(const SeqInfo& info)
+    {
+        sequence_ = info.sequence();
+        lines_ = static_cast<Mask>(info.lines().word(0));
+
+        return *this;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    void ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::insert(const std::size_t lineId)
+    {
+        lines_ = static_cast<Mask>(lines_ | (Mask(1) << lineId));
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    bool ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::has(const std::size_t lineId) const
+    {
+        return ((lines_ >> lineId) & 1) != 0;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    bool ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::complete() const
+    {
+        return lines_ == AllLines;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    bool ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::empty() const
+    {
+        return lines_ == 0;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    typename ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::LineSet ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::lines() const
+    {
+        return LineSet(lines_);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    SequenceType ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::sequence() const
+    {
+        return sequence_;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    void ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot::sequence(const SequenceType seq)
+    {
+        sequence_ = seq;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::ColumnHistory()
+    {
+        reset();
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    typename ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::Slot ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::operator[](const std::size_t position)
+    {
+        return Slot(sequences_[position], lines_[position]);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    void ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count)
+    {
+        SequenceType* sequences = sequences_.data() + position;
+        Mask* lines = lines_.data() + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            sequences[i] = static_cast<SequenceType>(firstSequence + i);
+        }
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            lines[i] = 0;
+        }
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    void ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::insert(const std::size_t position, const std::size_t count, const std::size_t lineId)
+    {
+        const auto line = static_cast<Mask>(Mask(1) << lineId);
+        Mask* lines = lines_.data() + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            lines[i] = static_cast<Mask>(lines[i] | line);
+        }
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth>
+    void ColumnHistory<SequenceType, NumberOfLines, HistoryDepth>::reset()
+    {
+        sequences_.fill(SequenceType());
+        lines_.fill(AllLines);
+    }
+}}
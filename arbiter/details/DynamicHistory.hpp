@@ -0,0 +1,347 @@
+#pragma once
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/HistoryConfig.hpp>
+#include <arbiter/HistoryPool.hpp>
+#include <arbiter/details/AlignedBuffer.hpp>
+#include <arbiter/details/BitOperations.hpp>
+#include <arbiter/details/LineMask.hpp>
+#include <arbiter/details/SequenceInfo.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace arbiter { namespace details {
+
+    // The line positions of a runtime sized cache, a view into DynamicHistory's block.
+    class LinePositions
+    {
+    public:
+        LinePositions() : positions_(nullptr), size_(0) {}
+        LinePositions(std::size_t* positions, const std::size_t size) : positions_(positions), size_(size) {}
+
+        std::size_t& operator[](const std::size_t lineId) { return positions_[lineId]; }
+        const std::size_t& operator[](const std::size_t lineId) const { return positions_[lineId]; }
+
+        std::size_t* begin() { return positions_; }
+        std::size_t* end() { return positions_ + size_; }
+
+        const std::size_t* begin() const { return positions_; }
+        const std::size_t* end() const { return positions_ + size_; }
+
+        std::size_t size() const { return size_; }
+
+    private:
+        std::size_t* positions_;
+        std::size_t size_;
+    };
+
+    // Structure of arrays history whose depth and line count are set at run
+    // time from a HistoryConfig. Line positions, sequence numbers and packed
+    // line masks share one cache line aligned block, either owned by the
+    // history or carved out of a HistoryPool. @MaxLines bounds the mask width.
+    // The block is sized for config.maxHistoryDepth slots, the history may
+    // grow() into them, pages beyond those in use are left untouched.
+    template<typename SequenceType, std::size_t MaxLines>
+    class DynamicHistory
+    {
+    public:
+        using SeqInfo = SequenceInfo<SequenceType, MaxLines>;
+        using LineSet = typename SeqInfo::LineSet;
+        using Mask = typename LineMaskType<MaxLines>::type;
+
+        class Slot
+        {
+        public:
+            Slot(SequenceType& sequence, Mask& lines, const Mask allLines);
+
+            inline Slot& operator=(const SeqInfo& info);
+
+            inline void insert(const std::size_t lineId);
+            inline bool has(const std::size_t lineId) const;
+
+            inline bool complete() const;
+            inline bool empty() const;
+
+            inline LineSet lines() const;   // lines beyond the configured count read as present
+
+            inline SequenceType sequence() const;
+            inline void sequence(const SequenceType seq);
+
+        private:
+            SequenceType& sequence_;
+            Mask& lines_;
+            const Mask allLines_;
+        };
+
+        explicit DynamicHistory(const HistoryConfig& config);
+
+        inline Slot operator[](const std::size_t position);
+
+        std::size_t size() const { return depth_; }
+        std::size_t capacity() const { return capacity_; }
+        std::size_t initialSize() const { return initialDepth_; }    // config.historyDepth
+        std::size_t numberOfLines() const { return lines_; }
+
+        inline std::size_t wrap(const std::size_t position) const;  // @position % size()
+
+        LinePositions linePositions() { return LinePositions(positions_, lines_); }
+
+        // write gap slots SeqInfo(@firstSequence), SeqInfo(@firstSequence + 1), ...
+        // to the contiguous span [@position, @position + @count), no wrapping.
+        void fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count);
+
+        // add @lineId to every slot of the contiguous span [@position, @position + @count), no wrapping.
+        void insert(const std::size_t position, const std::size_t count, const std::size_t lineId);
+
+        // grow to @depth (at most capacity()) slots, opening the new slots at @position: the slots
+        // from @position on move up by the growth and the new ones read as SeqInfo(). O(size() - @position).
+        void grow(const std::size_t depth, const std::size_t position);
+
+        // shrink to @depth slots, dropping the slots from @depth on but the first @count (at most
+        // @depth), which move to the start of the history over the slots dropped there. O(@count).
+        void shrink(const std::size_t depth, const std::size_t count);
+
+        // mark the slot at @position complete, as the slots grow() opens read.
+        void retire(const std::size_t position) { masks_[position] = allLines_; }
+
+        // return every slot to SeqInfo(), O(size()). A grown history returns to config.historyDepth.
+        void reset();
+
+        // as above, at @depth (at most capacity()) slots.
+        void reset(const std::size_t depth);
+
+        // bytes of the block for @config.
+        static std::size_t bytes(const HistoryConfig& config);
+
+    private:
+        static const HistoryConfig& validate(const HistoryConfig& config);
+
+        void resize(const std::size_t depth);
+
+    private:
+        const std::size_t lines_;
+        const std::size_t initialDepth_;
+        const std::size_t capacity_;
+        std::size_t depth_;
+        std::size_t depthMask_;         // depth_ - 1 when depth_ is a power of two, 0 otherwise
+        const Mask allLines_;
+
+        AlignedBuffer buffer_;          // empty when allocated from a HistoryPool
+
+        std::size_t* positions_;
+        SequenceType* sequences_;
+        Mask* masks_;
+    };
+
+
+    template<typename SequenceType, std::size_t MaxLines>
+    DynamicHistory<SequenceType, MaxLines>::Slot::Slot(SequenceType& sequence, Mask& lines, const Mask allLines)
+        : sequence_(sequence)
+        , lines_(lines)
+        , allLines_(allLines)
+    {
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    typename DynamicHistory<SequenceType, MaxLines>::Slot& DynamicHistory<SequenceType, MaxLines>::Slot::operator=(const SeqInfo& info)
+    {
+        sequence_ = info.sequence();
+        lines_ = static_cast<Mask>(info.lines().word(0) & allLines_);
+
+        return *this;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::Slot::insert(const std::size_t lineId)
+    {
+        lines_ = static_cast<Mask>(lines_ | (Mask(1) << lineId));
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    bool DynamicHistory<SequenceType, MaxLines>::Slot::has(const std::size_t lineId) const
+    {
+        return ((lines_ >> lineId) & 1) != 0;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    bool DynamicHistory<SequenceType, MaxLines>::Slot::complete() const
+    {
+        return lines_ == allLines_;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    bool DynamicHistory<SequenceType, MaxLines>::Slot::empty() const
+    {
+        return lines_ == 0;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    typename DynamicHistory<SequenceType, MaxLines>::LineSet DynamicHistory<SequenceType, MaxLines>::Slot::lines() const
+    {
+        return LineSet(static_cast<Mask>(lines_ | static_cast<Mask>(~allLines_)));
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    SequenceType DynamicHistory<SequenceType, MaxLines>::Slot::sequence() const
+    {
+        return sequence_;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::Slot::sequence(const SequenceType seq)
+    {
+        sequence_ = seq;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    DynamicHistory<SequenceType, MaxLines>::DynamicHistory(const HistoryConfig& config)
+        : lines_(validate(config).numberOfLines)
+        , initialDepth_(config.historyDepth)
+        , capacity_(config.maxHistoryDepth)
+        , depth_(config.historyDepth)
+        , depthMask_(isPowerOfTwo(config.historyDepth) ? config.historyDepth - 1 : 0)
+        , allLines_(static_cast<Mask>(config.numberOfLines == 64 ? ~0ULL : ((1ULL << (config.numberOfLines % 64)) - 1)))
+        , buffer_(config.pool == nullptr ? AlignedBuffer(bytes(config), config.hugePages) : AlignedBuffer())
+        , positions_(nullptr)
+        , sequences_(nullptr)
+        , masks_(nullptr)
+    {
+        unsigned char* memory = (config.pool == nullptr) ? buffer_.data() : config.pool->allocate(bytes(config));
+
+        positions_ = reinterpret_cast<std::size_t*>(memory);
+        memory += AlignedBuffer::align(lines_ * sizeof(std::size_t));
+
+        sequences_ = reinterpret_cast<SequenceType*>(memory);
+        memory += AlignedBuffer::align(capacity_ * sizeof(SequenceType));
+
+        masks_ = reinterpret_cast<Mask*>(memory);
+
+        for(std::size_t lineId = 0; lineId < lines_; ++lineId)
+        {
+            positions_[lineId] = 0;
+        }
+
+        reset();
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    typename DynamicHistory<SequenceType, MaxLines>::Slot DynamicHistory<SequenceType, MaxLines>::operator[](const std::size_t position)
+    {
+        return Slot(sequences_[position], masks_[position], allLines_);
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    std::size_t DynamicHistory<SequenceType, MaxLines>::wrap(const std::size_t position) const
+    {
+        return depthMask_ != 0 ? (position & depthMask_) : (position % depth_);
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count)
+    {
+        SequenceType* sequences = sequences_ + position;
+        Mask* lines = masks_ + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            sequences[i] = static_cast<SequenceType>(firstSequence + i);
+        }
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            lines[i] = 0;
+        }
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::insert(const std::size_t position, const std::size_t count, const std::size_t lineId)
+    {
+        const auto line = static_cast<Mask>(Mask(1) << lineId);
+        Mask* lines = masks_ + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            lines[i] = static_cast<Mask>(lines[i] | line);
+        }
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::grow(const std::size_t depth, const std::size_t position)
+    {
+        const std::size_t growth = depth - depth_;
+        const std::size_t moved = depth_ - position;
+
+        std::memmove(sequences_ + position + growth, sequences_ + position, moved * sizeof(SequenceType));
+        std::memmove(masks_ + position + growth, masks_ + position, moved * sizeof(Mask));
+
+        for(std::size_t i = position; i < position + growth; ++i)
+        {
+            sequences_[i] = SequenceType();
+            masks_[i] = allLines_;
+        }
+
+        resize(depth);
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::shrink(const std::size_t depth, const std::size_t count)
+    {
+        std::memcpy(sequences_, sequences_ + depth, count * sizeof(SequenceType));
+        std::memcpy(masks_, masks_ + depth, count * sizeof(Mask));
+
+        resize(depth);
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::reset()
+    {
+        reset(initialDepth_);
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::reset(const std::size_t depth)
+    {
+        resize(depth);
+
+        for(std::size_t i = 0; i < depth_; ++i)
+        {
+            sequences_[i] = SequenceType();
+        }
+
+        for(std::size_t i = 0; i < depth_; ++i)
+        {
+            masks_[i] = allLines_;
+        }
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    std::size_t DynamicHistory<SequenceType, MaxLines>::bytes(const HistoryConfig& config)
+    {
+        return AlignedBuffer::align(config.numberOfLines * sizeof(std::size_t))
+             + AlignedBuffer::align(config.maxHistoryDepth * sizeof(SequenceType))
+             + AlignedBuffer::align(config.maxHistoryDepth * sizeof(Mask));
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    const HistoryConfig& DynamicHistory<SequenceType, MaxLines>::validate(const HistoryConfig& config)
+    {
+        if((config.numberOfLines == 0) || (config.numberOfLines > MaxLines) || (config.historyDepth == 0))
+        {
+            throw InvalidHistoryConfig(config.numberOfLines, config.historyDepth, MaxLines);
+        }
+
+        if(config.maxHistoryDepth < config.historyDepth)
+        {
+            throw InvalidHistoryConfig("max history depth is less than history depth");
+        }
+
+        return config;
+    }
+
+    template<typename SequenceType, std::size_t MaxLines>
+    void DynamicHistory<SequenceType, MaxLines>::resize(const std::size_t depth)
+    {
+        depth_ = depth;
+        depthMask_ = isPowerOfTwo(depth) ? depth - 1 : 0;
+    }
+}}
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace arbiter { namespace details {
+
+    // History storage with an O(1) reset. Each slot is tagged with the
+    // generation it was last written in, reset() starts a new generation.
+    // A slot from an older generation reads as SeqInfo() on first touch.
+    template<class SeqInfo, std::size_t HistoryDepth>
+    class EpochHistory
+    {
+    public:
+        EpochHistory();
+
+        inline SeqInfo& operator[](const std::size_t position);
+
+        static constexpr std::size_t size() { return HistoryDepth; }
+
+        // write gap slots SeqInfo(@firstSequence), SeqInfo(@firstSequence + 1), ...
+        // to the contiguous span [@position, @position + @count), no wrapping.
+        template<typename SequenceType>
+        void fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count);
+
+        // add @lineId to every slot of the contiguous span [@position, @position + @count), no wrapping.
+        void insert(const std::size_t position, const std::size_t count, const std::size_t lineId);
+
+        // O(1), except once every 2^32 resets when the generation wraps.
+        void reset();
+
+    private:
+        struct Slot
+        {
+            SeqInfo info;
+            std::uint32_t generation;
+        };
+
+        std::array<Slot, HistoryDepth> history_;
+        std::uint32_t generation_;
+    };
+
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    EpochHistory<SeqInfo, HistoryDepth>::EpochHistory()
+        : generation_(1)
+    {
+        for(auto& slot : history_)
+        {
+            slot.generation = 0;    // stale, read as SeqInfo()
+        }
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    SeqInfo& EpochHistory<SeqInfo, HistoryDepth>::operator[](const std::size_t position)
+    {
+        auto& slot = history_[position];
+
+        if(slot.generation != generation_)
+        {
+            slot.info = SeqInfo();
+            slot.generation = generation_;
+        }
+
+        return slot.info;
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    template<typename SequenceType>
+    void EpochHistory<SeqInfo, HistoryDepth>::fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count)
+    {
+        Slot* slots = history_.data() + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            slots[i].info = SeqInfo(static_cast<SequenceType>(firstSequence + i));
+            slots[i].generation = generation_;
+        }
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    void EpochHistory<SeqInfo, HistoryDepth>::insert(const std::size_t position, const std::size_t count, const std::size_t lineId)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            (*this)[position + i].insert(lineId);   // a stale slot reads as SeqInfo() first
+        }
+    }
+
+    template<class SeqInfo, std::size_t HistoryDepth>
+    void EpochHistory<SeqInfo, HistoryDepth>::reset()
+    {
+        if(++generation_ == 0)
+        {
+            // generation wrapped, old tags could alias the new generation.
+            for(auto& slot : history_)
+            {
+                slot.generation = 0;
+            }
+
+            generation_ = 1;
+        }
+    }
+}}
@@ -0,0 +1,43 @@
+#pragma once
+
+namespace arbiter { namespace details {
+
+    // Holds the arbiter's ErrorReportingPolicy, either by reference to a
+    // policy owned by the caller or by value. By value the policy is a
+    // base class, so an empty policy adds nothing to the arbiter's size.
+    template<class ErrorReportingPolicy, bool ByValue>
+    class ErrorPolicyHolder;
+
+    template<class ErrorReportingPolicy>
+    class ErrorPolicyHolder<ErrorReportingPolicy, false>
+    {
+    public:
+        explicit ErrorPolicyHolder(ErrorReportingPolicy& errorPolicy)
+            : errorPolicy_(errorPolicy)
+        {
+        }
+
+        ErrorReportingPolicy& get() { return errorPolicy_; }
+
+    private:
+        ErrorReportingPolicy& errorPolicy_;
+    };
+
+    template<class ErrorReportingPolicy>
+    class ErrorPolicyHolder<ErrorReportingPolicy, true> : private ErrorReportingPolicy
+    {
+    public:
+        ErrorPolicyHolder()
+            : ErrorReportingPolicy()
+        {
+        }
+
+        // the holder keeps a copy of @errorPolicy.
+        explicit ErrorPolicyHolder(const ErrorReportingPolicy& errorPolicy)
+            : ErrorReportingPolicy(errorPolicy)
+        {
+        }
+
+        ErrorReportingPolicy& get() { return *this; }
+    };
+}}
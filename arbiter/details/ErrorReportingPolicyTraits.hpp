@@ -0,0 +1,91 @@
+#pragma once
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace arbiter { namespace details {
+
+    // Compile-time detection of optional ErrorReportingPolicy callbacks, and of
+    // the callbacks a policy leaves to NullErrorReportingPolicy. Reports* is
+    // false for a callback the policy inherits from NullErrorReportingPolicy
+    // without redefining, the arbiter then skips the call and the work which
+    // only feeds it. Overloaded or template callbacks always count as reported.
+    template<class ErrorReportingPolicy, class LineSet, class SequenceType>
+    struct ErrorReportingPolicyTraits
+    {
+    private:
+        using NullPolicy = NullErrorReportingPolicy<SequenceType>;
+
+        template<class Policy>
+        static auto hasUnrecoverableLineGaps(int) -> decltype(std::declval<Policy&>().UnrecoverableLineGaps(std::declval<const LineSet&>(), std::declval<SequenceType>()), std::true_type());
+
+        template<class Policy>
+        static std::false_type hasUnrecoverableLineGaps(...);
+
+        template<class Policy>
+        static auto hasGapFillLatency(int) -> decltype(std::declval<Policy&>().GapFillLatency(std::declval<SequenceType>(), std::declval<SequenceType>()), std::true_type());
+
+        template<class Policy>
+        static std::false_type hasGapFillLatency(...);
+
+        template<class Policy>
+        static auto hasFirstArrival(int) -> decltype(std::declval<Policy&>().FirstArrival(std::declval<std::size_t>(), std::declval<SequenceType>()), std::true_type());
+
+        template<class Policy>
+        static std::false_type hasFirstArrival(...);
+
+        template<class Policy>
+        static auto hasLateArrival(int) -> decltype(std::declval<Policy&>().LateArrival(std::declval<std::size_t>(), std::declval<SequenceType>(), std::declval<SequenceType>(), std::declval<std::uint64_t>()), std::true_type());
+
+        template<class Policy>
+        static std::false_type hasLateArrival(...);
+
+        // the class declaring a member function.
+        template<class Class, class Result, class... Args>
+        static Class declaredBy(Result (Class::*)(Args...));
+
+        template<class Class, class Result, class... Args>
+        static Class declaredBy(Result (Class::*)(Args...) const);
+
+#define ARBITER_DETECT_CALLBACK(Callback) \
+        template<class Policy> static constexpr bool reports##Callback(decltype(declaredBy(&Policy::Callback))*) { return !std::is_same<NullPolicy, decltype(declaredBy(&Policy::Callback))>::value; } \
+        template<class Policy> static constexpr bool reports##Callback(...) { return true; }
+
+        ARBITER_DETECT_CALLBACK(FirstSequenceNumberOutOfSequence)
+        ARBITER_DETECT_CALLBACK(DuplicateOnLine)
+        ARBITER_DETECT_CALLBACK(Gap)
+        ARBITER_DETECT_CALLBACK(GapFill)
+        ARBITER_DETECT_CALLBACK(LinePositionOverrun)
+        ARBITER_DETECT_CALLBACK(UnrecoverableGap)
+        ARBITER_DETECT_CALLBACK(UnrecoverableLineGap)
+
+#undef ARBITER_DETECT_CALLBACK
+
+    public:
+        // UnrecoverableLineGaps(missingLines, sequenceNumber) reports every missing line of a slot in one call.
+        using HasUnrecoverableLineGaps = decltype(hasUnrecoverableLineGaps<ErrorReportingPolicy>(0));
+
+        // GapFillLatency(sequenceNumber, latency) follows each GapFill() with how far behind head the fill was.
+        using HasGapFillLatency = decltype(hasGapFillLatency<ErrorReportingPolicy>(0));
+
+        // FirstArrival(line, sequenceNumber) is called for every accepted sequence number, the line won the race.
+        using HasFirstArrival = decltype(hasFirstArrival<ErrorReportingPolicy>(0));
+
+        // LateArrival(line, sequenceNumber, lagMessages, lagTicks) is called for the expected copy of an
+        // already accepted sequence number on another line.
+        using HasLateArrival = decltype(hasLateArrival<ErrorReportingPolicy>(0));
+
+        static constexpr bool ReportsFirstSequenceNumberOutOfSequence() { return reportsFirstSequenceNumberOutOfSequence<ErrorReportingPolicy>(nullptr); }
+        static constexpr bool ReportsDuplicateOnLine() { return reportsDuplicateOnLine<ErrorReportingPolicy>(nullptr); }
+        static constexpr bool ReportsGap() { return reportsGap<ErrorReportingPolicy>(nullptr); }
+        static constexpr bool ReportsGapFill() { return reportsGapFill<ErrorReportingPolicy>(nullptr); }
+        static constexpr bool ReportsLinePositionOverrun() { return reportsLinePositionOverrun<ErrorReportingPolicy>(nullptr); }
+        static constexpr bool ReportsUnrecoverableGap() { return reportsUnrecoverableGap<ErrorReportingPolicy>(nullptr); }
+
+        // UnrecoverableLineGap() or UnrecoverableLineGaps().
+        static constexpr bool ReportsUnrecoverableLineGaps() { return HasUnrecoverableLineGaps::value || reportsUnrecoverableLineGap<ErrorReportingPolicy>(nullptr); }
+    };
+}}
@@ -0,0 +1,263 @@
+#pragma once
+#include <arbiter/details/LineMask.hpp>
+#include <arbiter/details/SequenceInfo.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace arbiter { namespace details {
+
+    // History storage which keeps only a packed line mask per slot. Slots are
+    // written in ring order with consecutive sequence numbers, except when head
+    // jumps over an unrecoverable gap, so a slot's sequence number is derived
+    // from its distance to the newest slot. Each jump starts a new segment,
+    // at most @MaxSegments segments can be live in the history at once.
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    class ImplicitHistory
+    {
+    public:
+        using SeqInfo = SequenceInfo<SequenceType, NumberOfLines>;
+        using LineSet = typename SeqInfo::LineSet;
+        using Mask = typename LineMaskType<NumberOfLines>::type;
+
+        static constexpr Mask AllLines = LineMaskType<NumberOfLines>::AllLines;
+
+        class Slot
+        {
+        public:
+            Slot(ImplicitHistory& history, const std::size_t position);
+
+            inline Slot& operator=(const SeqInfo& info);
+
+            inline void insert(const std::size_t lineId);
+            inline bool has(const std::size_t lineId) const;
+
+            inline bool complete() const;
+            inline bool empty() const;
+
+            inline LineSet lines() const;
+            inline SequenceType sequence() const;
+
+        private:
+            ImplicitHistory& history_;
+            const std::size_t position_;
+        };
+
+        ImplicitHistory();
+
+        inline Slot operator[](const std::size_t position);
+
+        static constexpr std::size_t size() { return HistoryDepth; }
+
+        // write gap slots SeqInfo(@firstSequence), SeqInfo(@firstSequence + 1), ...
+        // to the contiguous span [@position, @position + @count), no wrapping.
+        void fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count);
+
+        // add @lineId to every slot of the contiguous span [@position, @position + @count), no wrapping.
+        void insert(const std::size_t position, const std::size_t count, const std::size_t lineId);
+
+        // return every slot to SeqInfo(), O(HistoryDepth)
+        void reset();
+
+    private:
+        // sequence numbers [firstSequence, ...) are stored from slot index firstIndex.
+        // Slot indexes count every slot written since reset, position = index % HistoryDepth.
+        struct Segment
+        {
+            std::size_t firstIndex;
+            SequenceType firstSequence;
+        };
+
+        inline SequenceType sequenceAt(const std::size_t position) const;
+
+        // record @count slots written from @position, starting at @firstSequence.
+        inline void append(const std::size_t position, const SequenceType firstSequence, const std::size_t count);
+
+    private:
+        std::array<Mask, HistoryDepth> lines_;
+
+        std::array<Segment, MaxSegments> segments_;     // ring, oldest at firstSegment_
+        std::size_t firstSegment_;
+        std::size_t segmentCount_;
+
+        std::size_t newestIndex_;       // index of the newest slot written
+        std::size_t newestPosition_;
+        SequenceType newestSequence_;
+    };
+
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    constexpr typename ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Mask ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::AllLines;
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::Slot(ImplicitHistory& history, const std::size_t position)
+        : history_(history)
+        , position_(position)
+    {
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    typename ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot& ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::operator=(const SeqInfo& info)
+    {
+        history_.lines_[position_] = static_cast<Mask>(info.lines().word(0));
+        history_.append(position_, info.sequence(), 1);
+
+        return *this;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    void ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::insert(const std::size_t lineId)
+    {
+        auto& lines = history_.lines_[position_];
+        lines = static_cast<Mask>(lines | (Mask(1) << lineId));
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    bool ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::has(const std::size_t lineId) const
+    {
+        return ((history_.lines_[position_] >> lineId) & 1) != 0;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    bool ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::complete() const
+    {
+        return history_.lines_[position_] == AllLines;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    bool ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::empty() const
+    {
+        return history_.lines_[position_] == 0;
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    typename ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::LineSet ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::lines() const
+    {
+        return LineSet(history_.lines_[position_]);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    SequenceType ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot::sequence() const
+    {
+        return history_.sequenceAt(position_);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::ImplicitHistory()
+    {
+        reset();
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    typename ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::Slot ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::operator[](const std::size_t position)
+    {
+        return Slot(*this, position);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    void ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::fill(const std::size_t position, const SequenceType firstSequence, const std::size_t count)
+    {
+        if(count == 0)
+        {
+            return;
+        }
+
+        Mask* lines = lines_.data() + position;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            lines[i] = 0;
+        }
+
+        append(position, firstSequence, count);
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    void ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::insert(const std::size_t position, const std::size_t count, const std::size_t lineId)
+    {
+        const auto line = static_cast<Mask>(Mask(1) << lineId);
+        Mask* lines = lines_.data() + position;
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            lines[i] = static_cast<Mask>(lines[i] | line);
+        }
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    void ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::reset()
+    {
+        lines_.fill(AllLines);
+
+        firstSegment_ = 0;
+        segmentCount_ = 0;
+
+        newestIndex_ = 0;
+        newestPosition_ = 0;
+        newestSequence_ = SequenceType();
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    SequenceType ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::sequenceAt(const std::size_t position) const
+    {
+        const std::size_t distance = (newestPosition_ >= position) ? (newestPosition_ - position) : (newestPosition_ + HistoryDepth - position);
+        if((segmentCount_ == 0) || (distance > newestIndex_))
+        {
+            return SequenceType();  // not written since reset
+        }
+
+        const std::size_t index = newestIndex_ - distance;
+
+        for(std::size_t i = segmentCount_; i > 0; --i)
+        {
+            const auto& segment = segments_[(firstSegment_ + i - 1) % MaxSegments];
+            if(index >= segment.firstIndex)
+            {
+                return static_cast<SequenceType>(segment.firstSequence + (index - segment.firstIndex));
+            }
+        }
+
+        return SequenceType();
+    }
+
+    template<typename SequenceType, std::size_t NumberOfLines, std::size_t HistoryDepth, std::size_t MaxSegments>
+    void ImplicitHistory<SequenceType, NumberOfLines, HistoryDepth, MaxSegments>::append(const std::size_t position, const SequenceType firstSequence, const std::size_t count)
+    {
+        const std::size_t nextPosition = (newestPosition_ + 1 == HistoryDepth) ? 0 : newestPosition_ + 1;
+        const bool continues = (segmentCount_ != 0) && (position == nextPosition) && (firstSequence == static_cast<SequenceType>(newestSequence_ + 1));
+
+        std::size_t firstIndex = position;
+        if(continues)
+        {
+            firstIndex = newestIndex_ + 1;
+        }
+        else
+        {
+            if(segmentCount_ != 0)
+            {
+                // the slots skipped over are overwritten before they're read again.
+                firstIndex = newestIndex_ + ((position > newestPosition_) ? (position - newestPosition_) : (position + HistoryDepth - newestPosition_));
+            }
+
+            if(segmentCount_ == MaxSegments)
+            {
+                firstSegment_ = (firstSegment_ + 1) % MaxSegments;
+                --segmentCount_;
+            }
+
+            segments_[(firstSegment_ + segmentCount_) % MaxSegments] = Segment{firstIndex, firstSequence};
+            ++segmentCount_;
+        }
+
+        newestIndex_ = firstIndex + count - 1;
+        newestPosition_ = position + count - 1;
+        newestSequence_ = static_cast<SequenceType>(firstSequence + (count - 1));
+
+        // drop segments which have been completely overwritten.
+        const std::size_t oldestIndex = newestIndex_ >= HistoryDepth ? newestIndex_ - (HistoryDepth - 1) : 0;
+        while((segmentCount_ > 1) && (segments_[(firstSegment_ + 1) % MaxSegments].firstIndex <= oldestIndex))
+        {
+            firstSegment_ = (firstSegment_ + 1) % MaxSegments;
+            --segmentCount_;
+        }
+    }
+}}
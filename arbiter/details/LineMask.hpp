@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace arbiter { namespace details {
+
+    // smallest unsigned integer with a bit for each line.
+    template<std::size_t NumberOfLines>
+    struct LineMaskType
+    {
+        static_assert(NumberOfLines <= 64, "packed line masks support at most 64 lines.");
+
+        using type =
+            typename std::conditional<(NumberOfLines <= 8), std::uint8_t,
+            typename std::conditional<(NumberOfLines <= 16), std::uint16_t,
+            typename std::conditional<(NumberOfLines <= 32), std::uint32_t, std::uint64_t>::type>::type>::type;
+
+        static constexpr type AllLines = static_cast<type>(NumberOfLines == 64 ? ~0ULL : ((1ULL << (NumberOfLines % 64)) - 1));
+    };
+
+    template<std::size_t NumberOfLines>
+    constexpr typename LineMaskType<NumberOfLines>::type LineMaskType<NumberOfLines>::AllLines;
+}}
@@ -1,57 +1,142 @@
 #pragma once 
-#include <bitset>
+#include <arbiter/details/BitOperations.hpp>
+#include <arbiter/details/BranchHints.hpp>
+
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace arbiter { namespace details {
 
     // track whether a line ID has appeared before
-    // or is missing.
+    // or is missing. Lines are kept as 64 bit words, the bits beyond
+    // NumberOfLines in the last word stay clear, so complete() and
+    // empty() compare whole words rather than count bits.
     template<std::size_t NumberOfLines>
     class LineSet
     {
     public:
+        LineSet();
+        explicit LineSet(const std::uint64_t firstWord);   // lines [0, 64) from the bits of @firstWord
 
-        bool insert(const std::size_t lineId);  // false if lineId in set already
+        bool insert(const std::size_t lineId);  // false if lineId in set already, throws std::out_of_range
         bool complete() const;   // true if all lines in set
         bool empty() const;      // true if no lines are in set
 
-        bool operator[](const std::size_t index);
+        bool operator[](const std::size_t index) const;
+
+        std::size_t count() const;  // number of lines in set
 
         std::vector<std::size_t> missing() const;
+        LineSet missingLines() const;   // the lines not in this set
+
+        // call @function(lineId) for each line in / missing from the set, lowest lineId first.
+        // These scan a 64 bit word at a time and don't allocate.
+        template<class Function> void forEach(Function&& function) const;
+        template<class Function> void forEachMissing(Function&& function) const;
 
         void fill();
 
+        std::uint64_t word(const std::size_t index) const { return words_[index]; }  // lines [64 * @index, 64 * @index + 64) as bits
+
     private:
-        std::bitset<NumberOfLines> value_;
+        static constexpr std::size_t WordBits = 64;
+        static constexpr std::size_t NumberOfWords = (NumberOfLines + WordBits - 1) / WordBits;
+
+        // every line of word @index.
+        static constexpr std::uint64_t fullWord(const std::size_t index)
+        {
+            return ((index + 1 < NumberOfWords) || (NumberOfLines % WordBits == 0)) ? ~0ULL : ((1ULL << (NumberOfLines % WordBits)) - 1);
+        }
+
+        // kept out of line so insert() stays small enough to inline.
+        [[noreturn]] static ARBITER_NOINLINE void outOfRange(const std::size_t lineId);
+
+    private:
+        std::array<std::uint64_t, NumberOfWords> words_;
     };
 
 
+    template<std::size_t NumberOfLines>
+    LineSet<NumberOfLines>::LineSet()
+        : words_()
+    {
+    }
+
+    template<std::size_t NumberOfLines>
+    LineSet<NumberOfLines>::LineSet(const std::uint64_t firstWord)
+        : words_()
+    {
+        words_[0] = firstWord & fullWord(0);
+    }
+
     template<std::size_t NumberOfLines>
     bool LineSet<NumberOfLines>::insert(const std::size_t lineId)
     {
-        bool returnValue = value_.test(lineId) == false;
-        value_.set(lineId);
+        if(ARBITER_UNLIKELY(lineId >= NumberOfLines))
+        {
+            outOfRange(lineId);
+        }
+
+        auto& word = words_[lineId / WordBits];
+        const std::uint64_t bit = 1ULL << (lineId % WordBits);
+
+        const bool returnValue = (word & bit) == 0;
+        word |= bit;
 
         return returnValue;
     }
 
+    template<std::size_t NumberOfLines>
+    void LineSet<NumberOfLines>::outOfRange(const std::size_t lineId)
+    {
+        throw std::out_of_range("LineSet: line " + std::to_string(lineId) + " is out of range");
+    }
+
     template<std::size_t NumberOfLines>
     bool LineSet<NumberOfLines>::complete() const
     {
-        return value_.count() == NumberOfLines;
+        // the differences from a full set are or'ed together, the loop has no early exit to vectorize.
+        std::uint64_t missingBits = 0;
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
+        {
+            missingBits |= words_[i] ^ fullWord(i);
+        }
+
+        return missingBits == 0;
     }
 
     template<std::size_t NumberOfLines>
     bool LineSet<NumberOfLines>::empty() const
     {
-        return value_.count() == 0;
+        std::uint64_t bits = 0;
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
+        {
+            bits |= words_[i];
+        }
+
+        return bits == 0;
     }
 
     template<std::size_t NumberOfLines>
-    bool LineSet<NumberOfLines>::operator[](const std::size_t index)
+    bool LineSet<NumberOfLines>::operator[](const std::size_t index) const
     {
-        return value_[index];
+        return ((words_[index / WordBits] >> (index % WordBits)) & 1) != 0;
+    }
+
+    template<std::size_t NumberOfLines>
+    std::size_t LineSet<NumberOfLines>::count() const
+    {
+        std::size_t total = 0;
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
+        {
+            total += populationCount(words_[i]);
+        }
+
+        return total;
     }
 
     template<std::size_t NumberOfLines>
@@ -60,20 +145,48 @@ namespace arbiter { namespace details {
         std::vector<std::size_t> missingLines;
         missingLines.reserve(NumberOfLines);
 
-        for(std::size_t i = 0, end = value_.size(); i < end; ++i)
+        forEachMissing([&missingLines](const std::size_t lineId) { missingLines.emplace_back(lineId); });
+        return missingLines;
+    }
+
+    template<std::size_t NumberOfLines>
+    LineSet<NumberOfLines> LineSet<NumberOfLines>::missingLines() const
+    {
+        LineSet lines;
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
         {
-            if(!value_[i])
-            {
-                missingLines.emplace_back(i);
-            }
+            lines.words_[i] = ~words_[i] & fullWord(i);
         }
 
-        return missingLines;
+        return lines;
+    }
+
+    template<std::size_t NumberOfLines>
+    template<class Function>
+    void LineSet<NumberOfLines>::forEach(Function&& function) const
+    {
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
+        {
+            details::forEachSetBit(words_[i], i * WordBits, function);
+        }
+    }
+
+    template<std::size_t NumberOfLines>
+    template<class Function>
+    void LineSet<NumberOfLines>::forEachMissing(Function&& function) const
+    {
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
+        {
+            details::forEachSetBit(~words_[i] & fullWord(i), i * WordBits, function);
+        }
     }
 
     template<std::size_t NumberOfLines>
     void LineSet<NumberOfLines>::fill()
     {
-        value_.set();
+        for(std::size_t i = 0; i < NumberOfWords; ++i)
+        {
+            words_[i] = fullWord(i);
+        }
     }
 }}
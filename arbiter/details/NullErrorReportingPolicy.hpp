@@ -18,10 +18,24 @@ namespace arbiter { namespace details {
 		void LinePositionOverrun(const std::size_t /*slowLine*/, const std::size_t /*overrunByLine*/){}
 
         // called when we're overwriting a gap in the arbiter cache history.
-		void UnrecoverableGap(const SequenceType /*start*/, const SequenceType /*length = 1*/){}
+		void UnrecoverableGap(const SequenceType /*start*/, const SequenceType /*length*/ = 1){}
 
         // called when we're overwriting a sequenceInfo in the cache history where 1 or more
         // lines didn't report, but at least 1 line did report (not a gap, but a line gap)
         void UnrecoverableLineGap(const std::size_t /*line*/, const SequenceType /*sequenceNumber*/){}
+
+        // Optional: a policy may instead define
+        //     template<class LineSet> void UnrecoverableLineGaps(const LineSet& missingLines, const SequenceType sequenceNumber);
+        // to receive every missing line of the overwritten sequenceInfo in one call.
+
+        // Optional: a policy may define
+        //     void GapFillLatency(const SequenceType sequenceNumber, const SequenceType latency);
+        // to be told, alongside GapFill(), how many sequence numbers head was ahead of @sequenceNumber when it was filled.
+
+        // Optional: a policy may define
+        //     void FirstArrival(const std::size_t line, const SequenceType sequenceNumber);
+        //     void LateArrival(const std::size_t line, const SequenceType sequenceNumber, const SequenceType lagMessages, const std::uint64_t lagTicks);
+        // to follow which line delivers each sequence number first, and how far behind head (and, with
+        // Traits::ArrivalTimestamps(), how long after the first arrival) the copies on other lines are.
 	};
 }}
@@ -0,0 +1,57 @@
+#pragma once
+#include <arbiter/HistoryLayout.hpp>
+#include <cstddef>
+
+namespace arbiter { namespace details {
+
+    // Optional Traits settings. Traits may define any of these as
+    // static constexpr functions, when they don't, the default is used.
+    template<class Traits>
+    struct OptionalTraits
+    {
+    private:
+        template<class T> static constexpr bool epochReset(decltype(T::EpochReset())*) { return T::EpochReset(); }
+        template<class T> static constexpr bool epochReset(...) { return false; }
+
+        template<class T> static constexpr bool powerOfTwoHistoryDepth(decltype(T::PowerOfTwoHistoryDepth())*) { return T::PowerOfTwoHistoryDepth(); }
+        template<class T> static constexpr bool powerOfTwoHistoryDepth(...) { return false; }
+
+        template<class T> static constexpr HistoryLayout layout(decltype(T::Layout())*) { return T::Layout(); }
+        template<class T> static constexpr HistoryLayout layout(...) { return HistoryLayout::ArrayOfStructures; }
+
+        template<class T> static constexpr bool errorReportingPolicyByValue(decltype(T::ErrorReportingPolicyByValue())*) { return T::ErrorReportingPolicyByValue(); }
+        template<class T> static constexpr bool errorReportingPolicyByValue(...) { return false; }
+
+        template<class T> static constexpr bool arrivalTimestamps(decltype(T::ArrivalTimestamps())*) { return T::ArrivalTimestamps(); }
+        template<class T> static constexpr bool arrivalTimestamps(...) { return false; }
+
+        template<class T> static constexpr bool serialNumberArithmetic(decltype(T::SerialNumberArithmetic())*) { return T::SerialNumberArithmetic(); }
+        template<class T> static constexpr bool serialNumberArithmetic(...) { return false; }
+
+        template<class T> static constexpr bool incrementalSnapshots(decltype(T::IncrementalSnapshots())*) { return T::IncrementalSnapshots(); }
+        template<class T> static constexpr bool incrementalSnapshots(...) { return false; }
+
+    public:
+        // reset() bumps a history generation instead of clearing every slot (default false).
+        static constexpr bool EpochReset() { return epochReset<Traits>(nullptr); }
+
+        // require HistoryDepth() to be a power of two, so history wraps with a mask (default false).
+        static constexpr bool PowerOfTwoHistoryDepth() { return powerOfTwoHistoryDepth<Traits>(nullptr); }
+
+        // memory layout of the history (default ArrayOfStructures).
+        static constexpr HistoryLayout Layout() { return layout<Traits>(nullptr); }
+
+        // the arbiter holds its ErrorReportingPolicy by value rather than by reference (default false).
+        static constexpr bool ErrorReportingPolicyByValue() { return errorReportingPolicyByValue<Traits>(nullptr); }
+
+        // keep the first arrival timestamp of every sequence in history, validate() takes a timestamp (default false).
+        static constexpr bool ArrivalTimestamps() { return arrivalTimestamps<Traits>(nullptr); }
+
+        // order sequence numbers with RFC 1982 serial number arithmetic, so they may wrap (default false).
+        static constexpr bool SerialNumberArithmetic() { return serialNumberArithmetic<Traits>(nullptr); }
+
+        // track the history slots changed since a snapshot, so snapshot() into the same buffer
+        // encodes only those rather than the whole history (default false).
+        static constexpr bool IncrementalSnapshots() { return incrementalSnapshots<Traits>(nullptr); }
+    };
+}}
@@ -0,0 +1,46 @@
+#pragma once
+#include <arbiter/details/OptionalTraits.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace arbiter { namespace details {
+
+    // Sequence number arithmetic for the arbiter states. Sums and differences
+    // are taken modulo the range of SequenceType (narrow types would otherwise
+    // be promoted to int). Ordering is plain comparison unless Traits define
+    // SerialNumberArithmetic(), then it is RFC 1982 serial number comparison:
+    // @a precedes @b when @b is less than half the SequenceType range ahead of
+    // @a, so arbitration carries on across a sequence number wrap.
+    template<class Traits>
+    struct SequenceArithmetic
+    {
+        using SequenceType = typename Traits::SequenceType;
+
+        static constexpr bool Serial = OptionalTraits<Traits>::SerialNumberArithmetic();
+        static_assert(!Serial || std::is_unsigned<SequenceType>::value, "SerialNumberArithmetic() requires an unsigned SequenceType.");
+
+        static SequenceType next(const SequenceType sequenceNumber) { return static_cast<SequenceType>(sequenceNumber + 1); }
+
+        // how far @to is ahead of @from.
+        static SequenceType distance(const SequenceType from, const SequenceType to) { return static_cast<SequenceType>(to - from); }
+
+        static SequenceType advance(const SequenceType sequenceNumber, const std::size_t count) { return static_cast<SequenceType>(sequenceNumber + count); }
+        static SequenceType retreat(const SequenceType sequenceNumber, const std::size_t count) { return static_cast<SequenceType>(sequenceNumber - count); }
+
+        static bool precedesOrEqual(const SequenceType a, const SequenceType b) { return precedesOrEqual(a, b, std::integral_constant<bool, Serial>()); }
+        static bool precedes(const SequenceType a, const SequenceType b) { return (a != b) && precedesOrEqual(a, b); }
+
+    private:
+        static bool precedesOrEqual(const SequenceType a, const SequenceType b, std::false_type /*serial*/) { return a <= b; }
+        static bool precedesOrEqual(const SequenceType a, const SequenceType b, std::true_type /*serial*/)
+        {
+            // a distance of exactly half the range is ambiguous (RFC 1982), treat it as ahead.
+            return distance(a, b) < static_cast<SequenceType>(std::numeric_limits<SequenceType>::max() / 2 + 1);
+        }
+    };
+
+    template<class Traits>
+    constexpr bool SequenceArithmetic<Traits>::Serial;
+}}
@@ -0,0 +1,117 @@
+#pragma once
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/details/AlignedBuffer.hpp>
+#include <arbiter/details/BitOperations.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace arbiter { namespace details {
+
+    // A bounded lock-free queue for exactly one producer thread and one
+    // consumer thread. Capacity is a power of two. Each side keeps a cached
+    // copy of the other side's index, so it only reads the shared index
+    // (and misses the other core's cache line) when the cached copy says the
+    // ring is full or empty.
+    template<class T>
+    class SpscRing
+    {
+    public:
+        explicit SpscRing(const std::size_t capacity);   // throws InvalidRingCapacity
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // producer: false when the ring is full.
+        inline bool tryPush(const T& value);
+
+        // consumer: the oldest value, nullptr when the ring is empty.
+        inline const T* front();
+
+        // consumer: drop the value returned by front().
+        inline void pop();
+
+        std::size_t capacity() const { return mask_ + 1; }
+
+    private:
+        static std::size_t validate(const std::size_t capacity);
+
+    private:
+        const std::size_t mask_;
+        std::unique_ptr<T[]> values_;
+        char padding0_[AlignedBuffer::CacheLineSize];
+
+        std::atomic<std::size_t> tail_;     // written by the producer
+        std::size_t cachedHead_;
+        char padding1_[AlignedBuffer::CacheLineSize];
+
+        std::atomic<std::size_t> head_;     // written by the consumer
+        std::size_t cachedTail_;
+        char padding2_[AlignedBuffer::CacheLineSize];
+    };
+
+
+    template<class T>
+    SpscRing<T>::SpscRing(const std::size_t capacity)
+        : mask_(validate(capacity) - 1)
+        , values_(new T[capacity])
+        , tail_(0)
+        , cachedHead_(0)
+        , head_(0)
+        , cachedTail_(0)
+    {
+    }
+
+    template<class T>
+    bool SpscRing<T>::tryPush(const T& value)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if(tail - cachedHead_ > mask_)
+        {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if(tail - cachedHead_ > mask_)
+            {
+                return false;
+            }
+        }
+
+        values_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template<class T>
+    const T* SpscRing<T>::front()
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if(head == cachedTail_)
+        {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if(head == cachedTail_)
+            {
+                return nullptr;
+            }
+        }
+
+        return &values_[head & mask_];
+    }
+
+    template<class T>
+    void SpscRing<T>::pop()
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template<class T>
+    std::size_t SpscRing<T>::validate(const std::size_t capacity)
+    {
+        if(!isPowerOfTwo(capacity))
+        {
+            throw InvalidRingCapacity(capacity);
+        }
+
+        return capacity;
+    }
+}}
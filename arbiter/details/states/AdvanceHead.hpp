@@ -1,6 +1,9 @@
 #pragma once
 #include <arbiter/details/ArbiterCacheAdvancerContext.hpp>
+#include <arbiter/details/ErrorReportingPolicyTraits.hpp>
+#include <arbiter/details/SequenceArithmetic.hpp>
 #include <cstddef>
+#include <type_traits>
 
 namespace arbiter { namespace details {
 
@@ -11,12 +14,32 @@ namespace arbiter { namespace details {
         using ErrorReportingPolicy = typename Traits::ErrorReportingPolicy;
         using SequenceType = typename Traits::SequenceType;
         using SeqInfo = SequenceInfo<SequenceType, Traits::NumberOfLines()>;
+        using LineSet = typename SeqInfo::LineSet;
+        using PolicyTraits = ErrorReportingPolicyTraits<ErrorReportingPolicy, LineSet, SequenceType>;
+        using Sequence = SequenceArithmetic<Traits>;
 
         bool advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber);
 
+        // advance head over the contiguous run [@firstSequenceNumber, @firstSequenceNumber + @count),
+        // every sequence in the run is accepted. Returns the number of sequences consumed (@count).
+        std::size_t advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, bool* accept);
+
+        // adapt the history depth before head advances @count slots from @newest. Incomplete
+        // slots dropped by a shrink are reported as if head had overwritten them, a bounded
+        // number per advance.
+        inline void adapt(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t newest, const std::size_t count);
+
+        // report the incomplete slots among the @count following @newest, which head is about
+        // to overwrite in one go, as advance() does slot by slot.
+        inline void overwrite(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t newest, const std::size_t count);
+
     private:
         void checkForSlowLineOverrun(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const std::size_t nextPosition);
-        void handleGaps(const SeqInfo& sequenceInfo, ErrorReportingPolicy& errorPolicy);
+        // @Slot is SeqInfo or a history layout's slot reference.
+        template<class Slot> void handleGaps(const Slot& sequenceInfo, ErrorReportingPolicy& errorPolicy);
+
+        template<class Slot> inline void reportLineGaps(const Slot& sequenceInfo, ErrorReportingPolicy& errorPolicy, std::true_type /*bulk*/);
+        template<class Slot> inline void reportLineGaps(const Slot& sequenceInfo, ErrorReportingPolicy& errorPolicy, std::false_type /*bulk*/);
     };
 
 
@@ -25,32 +48,112 @@ namespace arbiter { namespace details {
     {
         auto& cache = context.cache;
 
+        adapt(context, cache.positions[lineId], 1);
+        cache.retain(cache.positions[lineId], 1);
+
         auto nextPosition = cache.nextPosition(lineId);
-        auto& sequenceInfo = cache.history[nextPosition];
+        auto&& sequenceInfo = cache.history[nextPosition];
+
+        if(cache.mayOverrun(1))
+        {
+            checkForSlowLineOverrun(context, lineId, nextPosition);
+        }
 
-        checkForSlowLineOverrun(context, lineId, nextPosition);
-        handleGaps(sequenceInfo, context.errorPolicy);
+        handleGaps(sequenceInfo, context.errorPolicy());
 
         cache.history[nextPosition] = SeqInfo(lineId, sequenceNumber);
         cache.positions[lineId] = nextPosition;
+        cache.changes().advanced(1);
 
+        context.reportFirstArrival(lineId, sequenceNumber, nextPosition);
         return true;    // new sequence number, accept the message
     }
 
+    template<class Traits>
+    std::size_t AdvanceHead<Traits>::advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, bool* accept)
+    {
+        auto& cache = context.cache;
+
+        adapt(context, cache.positions[lineId], count);
+        auto position = cache.positions[lineId];
+
+        // lines are checked slot by slot only when the run may reach one.
+        const bool mayOverrun = cache.mayOverrun(count);
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            cache.retain(position, 1);
+            position = cache.wrap(position + 1);
+
+            if(mayOverrun)
+            {
+                checkForSlowLineOverrun(context, lineId, position);
+            }
+
+            handleGaps(cache.history[position], context.errorPolicy());
+
+            cache.history[position] = SeqInfo(lineId, Sequence::advance(firstSequenceNumber, i));
+            accept[i] = true;
+
+            context.reportFirstArrival(lineId, Sequence::advance(firstSequenceNumber, i), position);
+        }
+
+        cache.positions[lineId] = position;
+        cache.changes().advanced(count);
+        return count;
+    }
+
+    template<class Traits>
+    void AdvanceHead<Traits>::adapt(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t newest, const std::size_t count)
+    {
+        auto& cache = context.cache;
+        if(cache.adapt(newest, count) == 0)
+        {
+            return;
+        }
+
+        for(auto position = cache.dropping(newest); position != cache.NoPosition; position = cache.dropping(newest))
+        {
+            handleGaps(cache.history[position], context.errorPolicy());
+            cache.drop(position);
+        }
+
+        cache.shrink(newest);
+    }
+
+    template<class Traits>
+    void AdvanceHead<Traits>::overwrite(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t newest, const std::size_t count)
+    {
+        if(!PolicyTraits::ReportsUnrecoverableGap() && !PolicyTraits::ReportsUnrecoverableLineGaps())
+        {
+            return;
+        }
+
+        auto& cache = context.cache;
+        for(std::size_t i = 1; (i <= count) && (i <= cache.history.size()); ++i)
+        {
+            handleGaps(cache.history[cache.wrap(newest + i)], context.errorPolicy());
+        }
+    }
+
     template<class Traits>
     void AdvanceHead<Traits>::checkForSlowLineOverrun(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const std::size_t nextPosition)
     {
         auto& positions = context.cache.positions;
 
         std::size_t positionLineId = 0;
-        for(auto& position : positions)
+        for(const auto position : positions)
         {
             if(positionLineId != lineId)
             {
                 if(nextPosition == position)
                 {
-                    context.errorPolicy.LinePositionOverrun(positionLineId, lineId);
-                    position = (nextPosition + 1) % context.cache.history.size();
+                    if(PolicyTraits::ReportsLinePositionOverrun())
+                    {
+                        context.errorPolicy().LinePositionOverrun(positionLineId, lineId);
+                    }
+
+                    context.cache.overrun(positionLineId, context.cache.wrap(nextPosition + 1), 0);
                 }
             }
 
@@ -59,22 +162,46 @@ namespace arbiter { namespace details {
     }
 
     template<class Traits>
-    void AdvanceHead<Traits>::handleGaps(const SeqInfo& sequenceInfo, ErrorReportingPolicy& errorPolicy)
+    template<class Slot>
+    void AdvanceHead<Traits>::handleGaps(const Slot& sequenceInfo, ErrorReportingPolicy& errorPolicy)
     {
+        // nothing to inspect the slot for.
+        if(!PolicyTraits::ReportsUnrecoverableGap() && !PolicyTraits::ReportsUnrecoverableLineGaps())
+        {
+            return;
+        }
+
         if(!sequenceInfo.complete())
         {
             if(sequenceInfo.empty())
             {
-                errorPolicy.UnrecoverableGap(sequenceInfo.sequence());
-            }
-            else
-            {
-                const auto& missingLines = sequenceInfo.lines().missing();
-                for(auto line : missingLines)
+                if(PolicyTraits::ReportsUnrecoverableGap())
                 {
-                    errorPolicy.UnrecoverableLineGap(line, sequenceInfo.sequence());
+                    errorPolicy.UnrecoverableGap(sequenceInfo.sequence());
                 }
             }
+            else if(PolicyTraits::ReportsUnrecoverableLineGaps())
+            {
+                reportLineGaps(sequenceInfo, errorPolicy, typename PolicyTraits::HasUnrecoverableLineGaps());
+            }
         }
     }
+
+    template<class Traits>
+    template<class Slot>
+    void AdvanceHead<Traits>::reportLineGaps(const Slot& sequenceInfo, ErrorReportingPolicy& errorPolicy, std::true_type)
+    {
+        errorPolicy.UnrecoverableLineGaps(sequenceInfo.lines().missingLines(), sequenceInfo.sequence());
+    }
+
+    template<class Traits>
+    template<class Slot>
+    void AdvanceHead<Traits>::reportLineGaps(const Slot& sequenceInfo, ErrorReportingPolicy& errorPolicy, std::false_type)
+    {
+        const auto sequenceNumber = sequenceInfo.sequence();
+        sequenceInfo.lines().forEachMissing([&errorPolicy, sequenceNumber](const std::size_t line)
+        {
+            errorPolicy.UnrecoverableLineGap(line, sequenceNumber);
+        });
+    }
 }}
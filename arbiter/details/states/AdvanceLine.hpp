@@ -1,5 +1,6 @@
 #pragma once 
 #include <arbiter/details/ArbiterCacheAdvancerContext.hpp>
+#include <arbiter/details/ErrorReportingPolicyTraits.hpp>
 #include <cstddef>
 
 namespace arbiter { namespace details {
@@ -9,8 +10,21 @@ namespace arbiter { namespace details {
     {
     public:
         using SequenceType = typename Traits::SequenceType;
+        using LineSet = typename SequenceInfo<SequenceType, Traits::NumberOfLines()>::LineSet;
+        using PolicyTraits = ErrorReportingPolicyTraits<typename Traits::ErrorReportingPolicy, LineSet, SequenceType>;
+        using Sequence = SequenceArithmetic<Traits>;
 
         bool advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber);
+
+        // advance a non-head line over the contiguous run starting at @firstSequenceNumber.
+        // The run stops when the line catches up to head (the next sequence advances head)
+        // or the history no longer matches the run. Returns the number of sequences consumed.
+        std::size_t advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, bool* accept);
+
+    private:
+        // @lineId delivered a sequence another line already delivered, a duplicate if @lineId already had.
+        template<class Slot>
+        inline void reportCopy(ArbiterCacheAdvancerContext<Traits>& context, Slot&& sequenceInfo, const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position);
     };
 
 
@@ -20,18 +34,19 @@ namespace arbiter { namespace details {
         auto& cache = context.cache;
 
         auto nextPosition = cache.nextPosition(lineId);
-        auto& sequenceInfo = cache.history[nextPosition];
+        auto&& sequenceInfo = cache.history[nextPosition];
 
         bool sequenceMatch = sequenceNumber == sequenceInfo.sequence();
         bool accept = sequenceMatch && sequenceInfo.empty();
 
         if(accept)
         {
-            context.errorPolicy.GapFill(sequenceNumber, 1);
+            context.reportGapFill(sequenceNumber);
+            context.reportFirstArrival(lineId, sequenceNumber, nextPosition);
         }
-        else if(sequenceMatch && sequenceInfo.has(lineId))
+        else if(sequenceMatch)
         {
-            context.errorPolicy.DuplicateOnLine(lineId, sequenceNumber);
+            reportCopy(context, sequenceInfo, lineId, sequenceNumber, nextPosition);
         }
 
         sequenceInfo.insert(lineId);
@@ -39,4 +54,68 @@ namespace arbiter { namespace details {
 
         return accept;
     }
+
+    template<class Traits>
+    std::size_t AdvanceLine<Traits>::advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, bool* accept)
+    {
+        auto& cache = context.cache;
+        const auto historySize = cache.history.size();
+
+        auto position = cache.positions[lineId];
+        const auto headPosition = cache.positions[cache.head];
+
+        const std::size_t distanceToHead = cache.wrap(headPosition + historySize - position);
+        const std::size_t end = count < distanceToHead ? count : distanceToHead;
+
+        // the history is read slot by slot, @lineId is then added across the run's slots in one pass.
+        const auto runStart = cache.wrap(position + 1);
+        bool sequenceMatch = true;
+
+        std::size_t i = 0;
+        while(sequenceMatch && (i < end))
+        {
+            const auto sequenceNumber = Sequence::advance(firstSequenceNumber, i);
+
+            position = cache.wrap(position + 1);
+            auto&& sequenceInfo = cache.history[position];
+
+            sequenceMatch = sequenceNumber == sequenceInfo.sequence();
+            accept[i] = sequenceMatch && sequenceInfo.empty();
+
+            if(accept[i])
+            {
+                context.reportGapFill(sequenceNumber);
+                context.reportFirstArrival(lineId, sequenceNumber, position);
+            }
+            else if(sequenceMatch)
+            {
+                reportCopy(context, sequenceInfo, lineId, sequenceNumber, position);
+            }
+
+            ++i;    // a mismatch is consumed too, the rest of the run is no longer next for this line.
+        }
+
+        cache.insertLine(runStart, i, lineId);
+        cache.positions[lineId] = position;
+        return i;
+    }
+
+    template<class Traits>
+    template<class Slot>
+    void AdvanceLine<Traits>::reportCopy(ArbiterCacheAdvancerContext<Traits>& context, Slot&& sequenceInfo, const std::size_t lineId, const SequenceType sequenceNumber, const std::size_t position)
+    {
+        if(!PolicyTraits::ReportsDuplicateOnLine() && !context.ReportsLateArrival())
+        {
+            return;
+        }
+
+        if(sequenceInfo.has(lineId))
+        {
+            context.errorPolicy().DuplicateOnLine(lineId, sequenceNumber);
+        }
+        else
+        {
+            context.reportLateArrival(lineId, sequenceNumber, position);
+        }
+    }
 }}
@@ -7,7 +7,7 @@
 #include <arbiter/details/states/HeadForwardGapFill.hpp>
 #include <arbiter/details/states/LineForwardGapFill.hpp>
 
-#include <arbiter/Exceptions.hpp>
+#include <arbiter/details/BranchHints.hpp>
 
 namespace arbiter { namespace details {
 
@@ -18,7 +18,18 @@ namespace arbiter { namespace details {
     {
     public:
         using SequenceType = typename Traits::SequenceType;
-        
+
+        // the hot states, called directly by ArbiterCacheAdvancer's fast path.
+        inline bool advanceHead(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber)
+        {
+            return advanceHead_.advance(context, lineId, sequenceNumber);
+        }
+
+        inline bool advanceLine(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber)
+        {
+            return advanceLine_.advance(context, lineId, sequenceNumber);
+        }
+
         // perf: defining this method explicitly inline is giving the best performance
         bool advance(const ArbiterCacheAdvancerStateEnum state, ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber)
         {
@@ -37,10 +48,30 @@ namespace arbiter { namespace details {
                 case ArbiterCacheAdvancerStateEnum::InitialState:
                     return initialState_.advance(context, lineId, sequenceNumber);
                 case ArbiterCacheAdvancerStateEnum::NumberOfEntries:
-                    break;  // fall through
+                    break;
+            };
+
+            // determineState() returns one of the states above.
+            ARBITER_UNREACHABLE();
+        }
+
+        // advance over the contiguous run [@firstSequenceNumber, @firstSequenceNumber + @count).
+        // AdvanceHead and AdvanceLine consume as much of the run as they can in one pass,
+        // every other state consumes a single sequence. Returns the number of sequences consumed.
+        std::size_t advance(const ArbiterCacheAdvancerStateEnum state, ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType firstSequenceNumber, const std::size_t count, bool* accept)
+        {
+            switch(state)
+            {
+                case ArbiterCacheAdvancerStateEnum::AdvanceHead:
+                    return advanceHead_.advance(context, lineId, firstSequenceNumber, count, accept);
+                case ArbiterCacheAdvancerStateEnum::AdvanceLine:
+                    return advanceLine_.advance(context, lineId, firstSequenceNumber, count, accept);
+                default:
+                    break;
             };
-            
-            throw ArbiterCacheAdvancerStateEnumOutOfRange(static_cast<std::size_t>(state));
+
+            *accept = advance(state, context, lineId, firstSequenceNumber);
+            return 1;
         }
         
     private:
@@ -1,5 +1,6 @@
 #pragma once
 #include <arbiter/details/ArbiterCacheAdvancerContext.hpp>
+#include <arbiter/details/ErrorReportingPolicyTraits.hpp>
 #include <cstddef>
 
 namespace arbiter { namespace details {
@@ -10,6 +11,8 @@ namespace arbiter { namespace details {
     public:
         using SequenceType = typename Traits::SequenceType;
         using SeqInfo = SequenceInfo<SequenceType, Traits::NumberOfLines()>;
+        using Sequence = SequenceArithmetic<Traits>;
+        using PolicyTraits = ErrorReportingPolicyTraits<typename Traits::ErrorReportingPolicy, typename SeqInfo::LineSet, SequenceType>;
 
         bool advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber);
 
@@ -27,24 +30,40 @@ namespace arbiter { namespace details {
         auto position = positions[lineId];
         auto currentSequenceNumber = cache.history[position].sequence();
 
+        if(Sequence::distance(sequenceNumber, currentSequenceNumber) >= cache.history.size())
+        {
+            return false;   // older than our history, discard without a report.
+        }
+
         auto gapPosition = calculateGapPosition(cache.history.size(), position, currentSequenceNumber, sequenceNumber);
         auto sequenceMatch = sequenceNumber == cache.history[gapPosition].sequence();
         auto accept = sequenceMatch && cache.history[gapPosition].empty();
 
+        if(sequenceMatch)
+        {
+            cache.changes().written(cache, gapPosition);
+        }
+
         if(accept)
         {
             cache.history[gapPosition].insert(lineId);
-            context.errorPolicy.GapFill(sequenceNumber, 1);
+            context.reportGapFill(sequenceNumber);
+            context.reportFirstArrival(lineId, sequenceNumber, gapPosition);
         }
         else if(sequenceMatch)
         {
-            if(!cache.history[gapPosition].has(lineId))
+            if(!PolicyTraits::ReportsDuplicateOnLine() && !context.ReportsLateArrival())
+            {
+                cache.history[gapPosition].insert(lineId);
+            }
+            else if(!cache.history[gapPosition].has(lineId))
             {
                 cache.history[gapPosition].insert(lineId);
+                context.reportLateArrival(lineId, sequenceNumber, gapPosition);
             }
             else
             {
-                context.errorPolicy.DuplicateOnLine(lineId, sequenceNumber);
+                context.errorPolicy().DuplicateOnLine(lineId, sequenceNumber);
             }
         }
 
@@ -54,7 +73,7 @@ namespace arbiter { namespace details {
     template<class Traits>
     std::size_t GapFill<Traits>::calculateGapPosition(const std::size_t cacheSize, const std::size_t position, const SequenceType currentSequenceNumber, const SequenceType sequenceNumber)
     {
-        const std::size_t sequenceDifference = currentSequenceNumber - sequenceNumber;
+        const std::size_t sequenceDifference = Sequence::distance(sequenceNumber, currentSequenceNumber);
 
         if(sequenceDifference > position)
         {
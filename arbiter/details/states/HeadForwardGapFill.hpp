@@ -1,5 +1,7 @@
 #pragma once
 #include <arbiter/details/ArbiterCacheAdvancerContext.hpp>
+#include <arbiter/details/ErrorReportingPolicyTraits.hpp>
+#include <arbiter/details/states/AdvanceHead.hpp>
 #include <cstddef>
 
 namespace arbiter { namespace details {
@@ -10,6 +12,8 @@ namespace arbiter { namespace details {
     public:
         using SequenceType = typename Traits::SequenceType;
         using SeqInfo = SequenceInfo<SequenceType, Traits::NumberOfLines()>;
+        using Sequence = SequenceArithmetic<Traits>;
+        using PolicyTraits = ErrorReportingPolicyTraits<typename Traits::ErrorReportingPolicy, typename SeqInfo::LineSet, SequenceType>;
 
         bool advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber);
 
@@ -27,28 +31,33 @@ namespace arbiter { namespace details {
         auto& positions = context.cache.positions;
 
         std::size_t position = positions[lineId];
-        auto currentSequenceNumber = cache.history[position].sequence() + 1;
-        position = cache.nextPosition(lineId);
+        auto currentSequenceNumber = Sequence::next(cache.history[position].sequence());
 
-        auto gapSize = sequenceNumber - currentSequenceNumber;
+        std::size_t gapSize = Sequence::distance(currentSequenceNumber, sequenceNumber);
         handleUnrecoverableForwardGap(context, gapSize, currentSequenceNumber, sequenceNumber);
 
-        context.errorPolicy.Gap(currentSequenceNumber, gapSize);
+        // the gap's slots and the new head's.
+        AdvanceHead<Traits>().adapt(context, positions[lineId], gapSize + 1);
+        cache.retain(positions[lineId], gapSize + 1);
+        position = cache.nextPosition(lineId);
 
-        auto gapPosition = positions[lineId] + gapSize;
-        checkForSlowLineOverrun(context, lineId, position, gapPosition);
+        context.errorPolicy().Gap(currentSequenceNumber, gapSize);
 
-        while(currentSequenceNumber < sequenceNumber)
+        // the last gap slot, unwrapped from @position (head's slot may be the history's last).
+        // A LargestRecoverableGap() of 0 leaves no gap slot for a line to be overrun in.
+        if(cache.mayOverrun(gapSize + 1) && (gapSize != 0))
         {
-            cache.history[position] = SeqInfo(currentSequenceNumber++);
-
-            cache.positions[lineId] = position;
-            position = cache.nextPosition(lineId);
+            checkForSlowLineOverrun(context, lineId, position, position + gapSize - 1);
         }
 
+        AdvanceHead<Traits>().overwrite(context, positions[lineId], gapSize + 1);
+        position = cache.fillGap(position, currentSequenceNumber, Sequence::distance(currentSequenceNumber, sequenceNumber));
+
         positions[lineId] = position;
         cache.history[position] = SeqInfo(lineId, sequenceNumber);
+        cache.changes().advanced(gapSize + 1);
 
+        context.reportFirstArrival(lineId, sequenceNumber, position);
         return true;
     }
 
@@ -57,10 +66,10 @@ namespace arbiter { namespace details {
     {
         if(gapSize > Traits::LargestRecoverableGap())
         {
-            context.errorPolicy.UnrecoverableGap(currentSequenceNumber, gapSize - Traits::LargestRecoverableGap());
+            context.errorPolicy().UnrecoverableGap(currentSequenceNumber, gapSize - Traits::LargestRecoverableGap());
 
             gapSize = Traits::LargestRecoverableGap();
-            currentSequenceNumber = sequenceNumber - Traits::LargestRecoverableGap();
+            currentSequenceNumber = Sequence::retreat(sequenceNumber, Traits::LargestRecoverableGap());
         }
     }
 
@@ -68,16 +77,21 @@ namespace arbiter { namespace details {
     void HeadForwardGapFill<Traits>::checkForSlowLineOverrun(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const std::size_t position, const std::size_t gapPosition)
     {
         auto& positions = context.cache.positions;
+        const std::size_t count = gapPosition + 2 - position;   // the gap's slots and head's
 
         std::size_t positionLineId = 0;
-        for(auto& linePosition : positions)
+        for(const auto linePosition : positions)
         {
             if(positionLineId != lineId)
             {
                 if(overrunsLine(position, linePosition, gapPosition, context.cache.history.size()))
                 {
-                    context.errorPolicy.LinePositionOverrun(positionLineId, lineId);
-                    linePosition = (gapPosition + 1) % context.cache.history.size();
+                    if(PolicyTraits::ReportsLinePositionOverrun())
+                    {
+                        context.errorPolicy().LinePositionOverrun(positionLineId, lineId);
+                    }
+
+                    context.cache.overrun(positionLineId, context.cache.wrap(gapPosition + 1), count);
                 }
             }
 
@@ -10,6 +10,7 @@ namespace arbiter { namespace details {
     public:
         using SequenceType = typename Traits::SequenceType;
         using SeqInfo = SequenceInfo<SequenceType, Traits::NumberOfLines()>;
+        using Sequence = SequenceArithmetic<Traits>;
 
         bool advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber);
 
@@ -33,50 +34,46 @@ namespace arbiter { namespace details {
         context.cache.positions[lineId] = position;
         context.cache.head = lineId;
 
+        context.reportFirstArrival(lineId, sequenceNumber, position);
+
         return true;
     }
 
     template<class Traits>
     bool InitialState<Traits>::handleInitialGap(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber)
     {
-        if(sequenceNumber < Traits::FirstExpectedSequenceNumber())
+        if(Sequence::precedes(sequenceNumber, Traits::FirstExpectedSequenceNumber()))
         {
-            context.isFirstCall = true;
-            context.errorPolicy.FirstSequenceNumberOutOfSequence(lineId, sequenceNumber);
+            // head stays ArbiterCache::NoHead, the next message is handled as the first.
+            context.errorPolicy().FirstSequenceNumberOutOfSequence(lineId, sequenceNumber);
             return false;
         }
 
-        auto nextSequenceNumber = Traits::FirstExpectedSequenceNumber();
+        SequenceType nextSequenceNumber = Traits::FirstExpectedSequenceNumber();
 
-        auto gapSize = sequenceNumber - Traits::FirstExpectedSequenceNumber();
+        std::size_t gapSize = Sequence::distance(Traits::FirstExpectedSequenceNumber(), sequenceNumber);
         if(gapSize > Traits::LargestRecoverableGap())
         {
             auto unrecoverableLength = gapSize - Traits::LargestRecoverableGap();
-            context.errorPolicy.UnrecoverableGap(Traits::FirstExpectedSequenceNumber(), unrecoverableLength);
+            context.errorPolicy().UnrecoverableGap(Traits::FirstExpectedSequenceNumber(), unrecoverableLength);
 
-            nextSequenceNumber += unrecoverableLength;
+            nextSequenceNumber = Sequence::advance(nextSequenceNumber, unrecoverableLength);
             gapSize -= unrecoverableLength;
         }
 
         auto& cache = context.cache;
         auto& positions = context.cache.positions;
 
-        std::size_t position = 0;
-        context.errorPolicy.Gap(nextSequenceNumber, gapSize);
-
-        while(nextSequenceNumber < sequenceNumber)
-        {
-            cache.history[position] = SeqInfo(nextSequenceNumber++);
-            positions[lineId] = position;
-
-            position = cache.nextPosition(lineId);
-        }
+        context.errorPolicy().Gap(nextSequenceNumber, gapSize);
 
+        std::size_t position = cache.fillGap(0, nextSequenceNumber, Sequence::distance(nextSequenceNumber, sequenceNumber));
         positions[lineId] = position;
 
         cache.history[position] = SeqInfo(lineId, sequenceNumber);
         cache.head = lineId;
 
+        context.reportFirstArrival(lineId, sequenceNumber, position);
+
         return true;
     }
 }}
@@ -12,6 +12,8 @@ namespace arbiter { namespace details {
     {
     public:
         using SequenceType = typename Traits::SequenceType;
+        using Sequence = SequenceArithmetic<Traits>;
+
         bool advance(ArbiterCacheAdvancerContext<Traits>& context, const std::size_t lineId, const SequenceType sequenceNumber);
 
     private:
@@ -30,10 +32,10 @@ namespace arbiter { namespace details {
         auto headPosition = positions[cache.head];
         auto currentSequenceNumber = cache.history[position].sequence();
 
-        auto gapPosition = (position + sequenceNumber - currentSequenceNumber);
+        auto gapPosition = position + Sequence::distance(currentSequenceNumber, sequenceNumber);
         auto passesHead = overrunsHead(headPosition, position, gapPosition, cache.history.size());
 
-        gapPosition %= cache.history.size();   // stay inbounds of history buffer
+        gapPosition = cache.wrap(gapPosition);   // stay inbounds of history buffer
 
         if(passesHead)
         {
@@ -45,13 +47,20 @@ namespace arbiter { namespace details {
 
         if(accept)
         {
-            context.errorPolicy.GapFill(sequenceNumber, 1);
+            context.reportGapFill(sequenceNumber);
 
             positions[lineId] = gapPosition;
             cache.history[gapPosition].insert(lineId);
+
+            context.reportFirstArrival(lineId, sequenceNumber, gapPosition);
         }
         else if(sequenceMatch)
         {
+            if(context.ReportsLateArrival() && !cache.history[gapPosition].has(lineId))
+            {
+                context.reportLateArrival(lineId, sequenceNumber, gapPosition);
+            }
+
             positions[lineId] = gapPosition;
             cache.history[gapPosition].insert(lineId);
         }
@@ -66,7 +75,7 @@ namespace arbiter { namespace details {
         context.cache.positions[lineId] = context.cache.positions[context.cache.head];
         context.cache.head = lineId;
 
-        auto nextSequenceNumber = context.cache.history[context.cache.positions[lineId]].sequence() + 1;
+        auto nextSequenceNumber = Sequence::next(context.cache.history[context.cache.positions[lineId]].sequence());
         bool isNext = sequenceNumber == nextSequenceNumber;
 
         if(isNext)
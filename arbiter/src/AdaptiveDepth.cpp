@@ -0,0 +1,82 @@
+#include <arbiter/details/AdaptiveDepth.hpp>
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/details/BitOperations.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace arbiter { namespace details {
+
+    AdaptiveDepth::AdaptiveDepth()
+        : samples_(0)
+        , percentile_(0)
+        , headroom_(1)
+        , interval_(0)
+    {
+        clear();
+    }
+
+    AdaptiveDepth::AdaptiveDepth(const HistoryConfig& config)
+        : samples_(0)
+        , percentile_(validate(config).lagPercentile)
+        , headroom_(config.lagHeadroom)
+        , interval_(config.lagPercentile != 0 ? config.adaptInterval : 0)
+    {
+        clear();
+    }
+
+    bool AdaptiveDepth::record(const std::size_t lag, const std::size_t count)
+    {
+        buckets_[bitWidth(lag)] += count;
+        samples_ += count;
+
+        return samples_ >= interval_;
+    }
+
+    std::size_t AdaptiveDepth::percentileLag()
+    {
+        const auto wanted = static_cast<std::uint64_t>(std::ceil(percentile_ * static_cast<double>(samples_)));
+
+        std::uint64_t seen = 0;
+        std::size_t bucket = 0;
+
+        while((bucket + 1 < buckets_.size()) && (seen + buckets_[bucket] < wanted))
+        {
+            seen += buckets_[bucket++];
+        }
+
+        clear();
+        return bucket < 64 ? (std::size_t(1) << bucket) : std::numeric_limits<std::size_t>::max();
+    }
+
+    void AdaptiveDepth::clear()
+    {
+        buckets_.fill(0);
+        samples_ = 0;
+    }
+
+    const HistoryConfig& AdaptiveDepth::validate(const HistoryConfig& config)
+    {
+        if(config.lagPercentile == 0)
+        {
+            return config;
+        }
+
+        if(!(config.lagPercentile > 0) || !(config.lagPercentile <= 1))
+        {
+            throw InvalidHistoryConfig("lag percentile is outside (0, 1]");
+        }
+
+        if(!(config.lagHeadroom >= 1))
+        {
+            throw InvalidHistoryConfig("lag headroom is less than 1");
+        }
+
+        if(config.adaptInterval == 0)
+        {
+            throw InvalidHistoryConfig("adapt interval is 0");
+        }
+
+        return config;
+    }
+}}
@@ -0,0 +1,94 @@
+#include <arbiter/details/AlignedBuffer.hpp>
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+    #include <malloc.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace arbiter { namespace details {
+
+    constexpr std::size_t AlignedBuffer::CacheLineSize;
+    constexpr std::size_t AlignedBuffer::HugePageSize;
+
+    AlignedBuffer::AlignedBuffer()
+        : data_(nullptr)
+        , size_(0)
+    {
+    }
+
+    AlignedBuffer::AlignedBuffer(const std::size_t bytes, const bool hugePages)
+        : data_(nullptr)
+        , size_(bytes)
+    {
+        if(bytes == 0)
+        {
+            return;
+        }
+
+        const std::size_t alignment = hugePages ? HugePageSize : CacheLineSize;
+        const std::size_t length = (bytes + alignment - 1) / alignment * alignment;
+
+#ifdef _MSC_VER
+        data_ = static_cast<unsigned char*>(_aligned_malloc(length, alignment));
+#else
+        void* memory = nullptr;
+        data_ = (posix_memalign(&memory, alignment, length) == 0) ? static_cast<unsigned char*>(memory) : nullptr;
+#endif
+
+        if(data_ == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if(hugePages)
+        {
+            madvise(data_, length, MADV_HUGEPAGE);  // advisory, a failure leaves regular pages
+        }
+#endif
+    }
+
+    AlignedBuffer::~AlignedBuffer()
+    {
+        release();
+    }
+
+    AlignedBuffer::AlignedBuffer(AlignedBuffer&& other)
+        : data_(other.data_)
+        , size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    AlignedBuffer& AlignedBuffer::operator=(AlignedBuffer&& other)
+    {
+        if(this != &other)
+        {
+            release();
+
+            data_ = other.data_;
+            size_ = other.size_;
+
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    void AlignedBuffer::release()
+    {
+#ifdef _MSC_VER
+        _aligned_free(data_);
+#else
+        std::free(data_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+}}
@@ -7,4 +7,40 @@ namespace arbiter {
         : std::out_of_range("ArbiterCacheAdvancerStateEnum is out of range, value = " + std::to_string(value))
     {
     }
+
+    UnknownStream::UnknownStream(const std::size_t streamId)
+        : std::out_of_range("stream has not been added, stream id = " + std::to_string(streamId))
+    {
+    }
+
+    DuplicateStream::DuplicateStream(const std::size_t streamId)
+        : std::invalid_argument("stream has already been added, stream id = " + std::to_string(streamId))
+    {
+    }
+
+    StreamCapacityExceeded::StreamCapacityExceeded(const std::size_t capacity)
+        : std::length_error("all streams are in use, capacity = " + std::to_string(capacity))
+    {
+    }
+
+    InvalidHistoryConfig::InvalidHistoryConfig(const std::size_t numberOfLines, const std::size_t historyDepth, const std::size_t maxNumberOfLines)
+        : std::invalid_argument("history config is invalid, number of lines = " + std::to_string(numberOfLines)
+            + " (1 to " + std::to_string(maxNumberOfLines) + "), history depth = " + std::to_string(historyDepth) + " (at least 1)")
+    {
+    }
+
+    InvalidHistoryConfig::InvalidHistoryConfig(const char* reason)
+        : std::invalid_argument(std::string("history config is invalid, ") + reason)
+    {
+    }
+
+    InvalidRingCapacity::InvalidRingCapacity(const std::size_t capacity)
+        : std::invalid_argument("ring capacity must be a power of two, capacity = " + std::to_string(capacity))
+    {
+    }
+
+    InvalidSnapshot::InvalidSnapshot(const char* reason)
+        : std::invalid_argument(std::string("snapshot can't be restored, ") + reason)
+    {
+    }
 }
@@ -0,0 +1,17 @@
+#include <arbiter/HistoryConfig.hpp>
+
+namespace arbiter {
+
+    HistoryConfig::HistoryConfig(const std::size_t numberOfLines, const std::size_t historyDepth, const bool hugePages, HistoryPool* pool)
+        : numberOfLines(numberOfLines)
+        , historyDepth(historyDepth)
+        , hugePages(hugePages)
+        , pool(pool)
+        , maxHistoryDepth(historyDepth)
+        , minimumAge(0)
+        , lagPercentile(0)
+        , lagHeadroom(2)
+        , adaptInterval(1 << 16)
+    {
+    }
+}
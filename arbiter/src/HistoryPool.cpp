@@ -0,0 +1,25 @@
+#include <arbiter/HistoryPool.hpp>
+#include <new>
+
+namespace arbiter {
+
+    HistoryPool::HistoryPool(const std::size_t bytes, const bool hugePages)
+        : buffer_(details::AlignedBuffer::align(bytes), hugePages)
+        , used_(0)
+    {
+    }
+
+    unsigned char* HistoryPool::allocate(const std::size_t bytes)
+    {
+        const std::size_t length = details::AlignedBuffer::align(bytes);
+        if(length > buffer_.size() - used_)
+        {
+            throw std::bad_alloc();
+        }
+
+        unsigned char* memory = buffer_.data() + used_;
+        used_ += length;
+
+        return memory;
+    }
+}
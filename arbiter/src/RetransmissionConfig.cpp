@@ -0,0 +1,13 @@
+#include <arbiter/RetransmissionConfig.hpp>
+
+namespace arbiter {
+
+    RetransmissionConfig::RetransmissionConfig(const std::uint64_t delay, const std::uint64_t retryInterval, const std::size_t mergeDistance, const std::size_t maxRangeLength, const std::size_t maxRequests)
+        : delay(delay)
+        , retryInterval(retryInterval)
+        , mergeDistance(mergeDistance)
+        , maxRangeLength(maxRangeLength)
+        , maxRequests(maxRequests)
+    {
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "./FeedGenerator.hpp"
+
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace benchmark {
+
+    template<std::size_t Lines, std::size_t Depth>
+    struct BenchmarkTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return Depth / 2; }
+        static constexpr std::size_t NumberOfLines() { return Lines; }
+        static constexpr std::size_t HistoryDepth() { return Depth; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = arbiter::details::NullErrorReportingPolicy<std::size_t>;
+    };
+
+    // owns the error policy and the (potentially large) arbiter on the heap.
+    template<class Traits>
+    struct ArbiterFixture
+    {
+        ArbiterFixture()
+            : arbiter(errorPolicy)
+        {
+        }
+
+        typename Traits::ErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter;
+    };
+
+    template<class Traits>
+    std::unique_ptr<ArbiterFixture<Traits>> makeArbiter()
+    {
+        return std::unique_ptr<ArbiterFixture<Traits>>(new ArbiterFixture<Traits>());
+    }
+
+    template<class Traits>
+    bool validate(ArbiterFixture<Traits>& fixture, const Message& message)
+    {
+        return fixture.arbiter.validate(message.line, message.sequence);
+    }
+
+    inline std::string benchmarkName(const std::string& name, const std::size_t lines, const std::size_t depth)
+    {
+        return name + "/lines:" + std::to_string(lines) + "/depth:" + std::to_string(depth);
+    }
+
+    // replay @feed through a SequenceArbiter, sampling latency for messages tagged @tag.
+    template<class Traits>
+    void measureArbiter(const std::string& name, const Feed& feed, const Tag tag)
+    {
+        measure(benchmarkName(name, Traits::NumberOfLines(), Traits::HistoryDepth()), feed,
+            &makeArbiter<Traits>,
+            &validate<Traits>,
+            [tag](const Message& message) { return message.tag == tag; });
+    }
+
+    template<std::size_t Lines, std::size_t Depth>
+    void measureArbiter(const std::string& name, const Feed& feed, const Tag tag)
+    {
+        measureArbiter<BenchmarkTraits<Lines, Depth>>(name, feed, tag);
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace benchmark {
+
+    // the arbiter state a message is constructed to exercise.
+    enum class Tag : std::uint8_t
+    {
+        AdvanceHead,
+        AdvanceLine,
+        GapFill,
+        HeadForwardGapFill,
+        LineForwardGapFill,
+        Mixed,              // realistic feeds, any state
+    };
+
+    struct Message
+    {
+        std::size_t line;
+        std::size_t sequence;
+        Tag tag;
+    };
+
+    using Feed = std::vector<Message>;
+
+    // every line delivers every sequence in turn, line 0 first.
+    // Line 0 messages advance head, every other line advances behind it.
+    inline Feed lockstepFeed(const std::size_t lines, const std::size_t sequences)
+    {
+        Feed feed;
+        feed.reserve(lines * sequences);
+
+        for(std::size_t sequence = 0; sequence < sequences; ++sequence)
+        {
+            feed.push_back(Message{0, sequence, Tag::AdvanceHead});
+            for(std::size_t line = 1; line < lines; ++line)
+            {
+                feed.push_back(Message{line, sequence, Tag::AdvanceLine});
+            }
+        }
+
+        return feed;
+    }
+
+    // line 0 delivers each pair of sequences swapped (n + 1, n), opening a
+    // single message forward gap and then filling it. The other lines follow in order.
+    inline Feed reorderedLeadFeed(const std::size_t lines, const std::size_t sequences)
+    {
+        Feed feed;
+        feed.reserve(lines * sequences);
+
+        feed.push_back(Message{0, 0, Tag::Mixed});
+        for(std::size_t line = 1; line < lines; ++line)
+        {
+            feed.push_back(Message{line, 0, Tag::Mixed});
+        }
+
+        for(std::size_t sequence = 1; sequence + 1 < sequences; sequence += 2)
+        {
+            feed.push_back(Message{0, sequence + 1, Tag::HeadForwardGapFill});
+            feed.push_back(Message{0, sequence, Tag::GapFill});
+
+            for(std::size_t line = 1; line < lines; ++line)
+            {
+                feed.push_back(Message{line, sequence, Tag::AdvanceLine});
+                feed.push_back(Message{line, sequence + 1, Tag::AdvanceLine});
+            }
+        }
+
+        return feed;
+    }
+
+    // line 0 delivers every sequence, the other lines lose every other
+    // message while staying behind head, so they forward gap fill.
+    inline Feed skippingFollowerFeed(const std::size_t lines, const std::size_t sequences)
+    {
+        Feed feed;
+        feed.reserve(lines * sequences);
+
+        feed.push_back(Message{0, 0, Tag::Mixed});
+        for(std::size_t line = 1; line < lines; ++line)
+        {
+            feed.push_back(Message{line, 0, Tag::Mixed});
+        }
+
+        for(std::size_t sequence = 1; sequence + 1 < sequences; sequence += 2)
+        {
+            feed.push_back(Message{0, sequence, Tag::AdvanceHead});
+            feed.push_back(Message{0, sequence + 1, Tag::AdvanceHead});
+
+            for(std::size_t line = 1; line < lines; ++line)
+            {
+                feed.push_back(Message{line, sequence + 1, Tag::LineForwardGapFill});
+            }
+        }
+
+        return feed;
+    }
+
+    // Per line network characteristics for a realistic A/B feed.
+    struct LineProfile
+    {
+        double latency;     // fixed delay, in message intervals
+        double jitter;      // mean of an exponential delay, in message intervals
+        double loss;        // probability a message is lost
+    };
+
+    // Every line carries the same sequence stream, each message arrives after
+    // its line's latency plus jitter. Lines stay FIFO (a message never overtakes
+    // the one before it on the same line) and the feed is merged by arrival time.
+    inline Feed interleavedFeed(const std::vector<LineProfile>& profiles, const std::size_t sequences, const std::uint64_t seed = 42)
+    {
+        struct Arrival
+        {
+            double time;
+            Message message;
+        };
+
+        std::mt19937_64 random(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        std::vector<Arrival> arrivals;
+        arrivals.reserve(profiles.size() * sequences);
+
+        for(std::size_t line = 0; line < profiles.size(); ++line)
+        {
+            const auto& profile = profiles[line];
+            std::exponential_distribution<double> jitter(profile.jitter > 0 ? 1.0 / profile.jitter : 1.0);
+
+            double lastArrival = 0;
+            for(std::size_t sequence = 0; sequence < sequences; ++sequence)
+            {
+                if((sequence != 0) && (uniform(random) < profile.loss))
+                {
+                    continue;
+                }
+
+                double arrival = static_cast<double>(sequence) + profile.latency + (profile.jitter > 0 ? jitter(random) : 0.0);
+                lastArrival = std::max(lastArrival, arrival);
+
+                arrivals.push_back(Arrival{lastArrival, Message{line, sequence, Tag::Mixed}});
+            }
+        }
+
+        std::stable_sort(arrivals.begin(), arrivals.end(), [](const Arrival& lhs, const Arrival& rhs) { return lhs.time < rhs.time; });
+
+        Feed feed;
+        feed.reserve(arrivals.size());
+
+        for(const auto& arrival : arrivals)
+        {
+            feed.push_back(arrival.message);
+        }
+
+        return feed;
+    }
+}
@@ -0,0 +1,214 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+
+#include <arbiter/ArbiterStage.hpp>
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// end to end latency, from a line thread receiving a message to the arbiter accepting it, of
+// a thread per line feeding an ArbiterStage drained by one consumer thread vs every line thread
+// calling validate() on a SequenceArbiter behind a mutex. The lines deliver the same paced feed,
+// line 1 @skew messages behind line 0. Gap fills counts the GapFill transitions the arbiter saw.
+// Spin loops yield, so the benchmark still completes on a single core (where the numbers mostly
+// measure the scheduler).
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Lines = 2;
+    constexpr std::size_t Depth = 4096;
+    constexpr std::size_t Sequences = 1 << 16;
+    constexpr std::size_t RingCapacity = 1024;
+
+    // called by the consumer thread, or under the mutex.
+    class GapFillCountingPolicy : public arbiter::details::NullErrorReportingPolicy<std::size_t>
+    {
+    public:
+        void GapFill(const std::size_t, const std::size_t length) { gapFills += length; }
+
+        std::size_t gapFills = 0;
+    };
+
+    struct StageTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        using ErrorReportingPolicy = GapFillCountingPolicy;
+    };
+
+    struct Pacing
+    {
+        std::uint64_t start;
+        std::uint64_t period;   // ticks between messages on a line
+        std::size_t skew;       // messages line 1 trails line 0 by
+
+        std::uint64_t due(const std::size_t line, const std::size_t sequence) const
+        {
+            return start + (sequence + (line == 0 ? 0 : skew)) * period;
+        }
+
+        void wait(const std::size_t line, const std::size_t sequence) const
+        {
+            const auto when = due(line, sequence);
+            while(ticks() < when)
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    Pacing pacing(const double periodNanos, const std::size_t skew)
+    {
+        // leave the threads time to start.
+        const auto ticksPerNano = 1.0 / nanosPerTick();
+        return Pacing{ticks() + static_cast<std::uint64_t>(1000000 * ticksPerNano), static_cast<std::uint64_t>(periodNanos * ticksPerNano), skew};
+    }
+
+    Result summarise(const std::string& name, std::vector<double>& latencies, const std::uint64_t elapsedTicks, const std::size_t gapFills)
+    {
+        Result result;
+        result.name = name + "/gapfills:" + std::to_string(gapFills);
+        result.messages = Lines * Sequences;
+        result.sampled = latencies.size();
+        result.feedNanosPerMessage = static_cast<double>(elapsedTicks) * nanosPerTick() / static_cast<double>(result.messages);
+        result.branchMissesPerMessage = -1;
+
+        double total = 0;
+        for(auto& latency : latencies)
+        {
+            latency *= nanosPerTick();
+            total += latency;
+        }
+
+        result.meanNanos = latencies.empty() ? 0 : total / static_cast<double>(latencies.size());
+        result.p50 = percentile(latencies, 0.50);
+        result.p99 = percentile(latencies, 0.99);
+        result.p999 = percentile(latencies, 0.999);
+
+        Registry::report(result);
+        return result;
+    }
+
+    void measureStage(const std::string& name, const double periodNanos, const std::size_t skew)
+    {
+        GapFillCountingPolicy errorPolicy;
+        std::unique_ptr<arbiter::ArbiterStage<StageTraits, std::uint64_t>> stage(new arbiter::ArbiterStage<StageTraits, std::uint64_t>(errorPolicy, RingCapacity));
+
+        const auto paced = pacing(periodNanos, skew);
+        std::atomic<std::size_t> running(Lines);
+        std::vector<std::thread> lines;
+
+        for(std::size_t line = 0; line < Lines; ++line)
+        {
+            lines.emplace_back([&, line]
+            {
+                for(std::size_t sequence = 0; sequence < Sequences; ++sequence)
+                {
+                    paced.wait(line, sequence);
+
+                    const auto received = ticks();
+                    while(!stage->push(line, sequence, received))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                --running;
+            });
+        }
+
+        std::vector<double> latencies;
+        latencies.reserve(Sequences);
+
+        auto accept = [&latencies](std::size_t, std::size_t, const std::uint64_t received) { latencies.push_back(static_cast<double>(ticks() - received)); };
+        auto reject = [](std::size_t, std::size_t, std::uint64_t) {};
+
+        while(running.load(std::memory_order_acquire) != 0)
+        {
+            if(stage->drain(accept, reject) == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        stage->drain(accept, reject);
+        const auto end = ticks();
+
+        for(auto& line : lines)
+        {
+            line.join();
+        }
+
+        summarise(name + "_Stage", latencies, end - paced.start, errorPolicy.gapFills);
+    }
+
+    void measureMutex(const std::string& name, const double periodNanos, const std::size_t skew)
+    {
+        GapFillCountingPolicy errorPolicy;
+        std::unique_ptr<arbiter::SequenceArbiter<StageTraits>> arbiter(new arbiter::SequenceArbiter<StageTraits>(errorPolicy));
+        std::mutex mutex;
+
+        const auto paced = pacing(periodNanos, skew);
+        std::vector<std::vector<double>> lineLatencies(Lines);
+        std::vector<std::thread> lines;
+
+        for(std::size_t line = 0; line < Lines; ++line)
+        {
+            lineLatencies[line].reserve(Sequences);
+            lines.emplace_back([&, line]
+            {
+                for(std::size_t sequence = 0; sequence < Sequences; ++sequence)
+                {
+                    paced.wait(line, sequence);
+
+                    const auto received = ticks();
+                    bool accepted = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        accepted = arbiter->validate(line, sequence);
+                    }
+
+                    if(accepted)
+                    {
+                        lineLatencies[line].push_back(static_cast<double>(ticks() - received));
+                    }
+                }
+            });
+        }
+
+        for(auto& line : lines)
+        {
+            line.join();
+        }
+
+        const auto end = ticks();
+
+        std::vector<double> latencies;
+        for(auto& line : lineLatencies)
+        {
+            latencies.insert(latencies.end(), line.begin(), line.end());
+        }
+
+        summarise(name + "_Mutex", latencies, end - paced.start, errorPolicy.gapFills);
+    }
+
+    void measureBoth(const std::string& name, const double periodNanos, const std::size_t skew)
+    {
+        measureStage(name, periodNanos, skew);
+        measureMutex(name, periodNanos, skew);
+    }
+
+    BENCHMARK(ArbiterStage)
+    {
+        measureBoth("Stage_AB_Level/period:500ns", 500, 0);
+        measureBoth("Stage_AB_Skew8/period:500ns", 500, 8);
+        measureBoth("Stage_AB_Level/period:100ns", 100, 0);
+    }
+}
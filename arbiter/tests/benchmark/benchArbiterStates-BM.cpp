@@ -0,0 +1,51 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <cstddef>
+
+// ns/message for each arbiter state, across line counts and history depths.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Sequences = 1 << 18;
+
+    template<std::size_t Lines, std::size_t Depth>
+    void measureStates()
+    {
+        const auto lockstep = lockstepFeed(Lines, Sequences);
+        measureArbiter<Lines, Depth>("AdvanceHead", lockstep, Tag::AdvanceHead);
+
+        if(Lines > 1)
+        {
+            measureArbiter<Lines, Depth>("AdvanceLine", lockstep, Tag::AdvanceLine);
+        }
+
+        const auto reordered = reorderedLeadFeed(Lines, Sequences);
+        measureArbiter<Lines, Depth>("GapFill", reordered, Tag::GapFill);
+        measureArbiter<Lines, Depth>("HeadForwardGapFill", reordered, Tag::HeadForwardGapFill);
+
+        if(Lines > 1)
+        {
+            const auto skipping = skippingFollowerFeed(Lines, Sequences);
+            measureArbiter<Lines, Depth>("LineForwardGapFill", skipping, Tag::LineForwardGapFill);
+        }
+    }
+
+    template<std::size_t Lines>
+    void measureDepths()
+    {
+        measureStates<Lines, 64>();
+        measureStates<Lines, 4096>();
+        measureStates<Lines, 65536>();
+    }
+
+    BENCHMARK(ArbiterStates_1Line) { measureDepths<1>(); }
+    BENCHMARK(ArbiterStates_2Lines) { measureDepths<2>(); }
+    BENCHMARK(ArbiterStates_4Lines) { measureDepths<4>(); }
+    BENCHMARK(ArbiterStates_16Lines) { measureDepths<16>(); }
+    BENCHMARK(ArbiterStates_32Lines) { measureDepths<32>(); }
+    BENCHMARK(ArbiterStates_64Lines) { measureDepths<64>(); }
+    BENCHMARK(ArbiterStates_128Lines) { measureDepths<128>(); }
+}
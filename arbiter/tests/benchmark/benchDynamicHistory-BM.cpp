@@ -0,0 +1,91 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <arbiter/HistoryLayout.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// cost of sizing the history at run time, compile time StructureOfArrays vs Dynamic with the
+// same depth and line count, and Dynamic with a depth which wraps with a modulo. Then a Dynamic
+// history reserved for 1M slots adapting its depth to the lag against one fixed at 1M slots.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Sequences = 1 << 21;
+
+    template<std::size_t Lines, std::size_t Depth>
+    struct ColumnTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::StructureOfArrays; }
+    };
+
+    // the arbiter fixture sizes the history from NumberOfLines() and HistoryDepth().
+    template<std::size_t Lines, std::size_t Depth>
+    struct DynamicTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::Dynamic; }
+    };
+
+    // starts at 4096 slots and follows the lag, up to Depth.
+    template<std::size_t Depth>
+    struct AdaptiveFixture
+    {
+        AdaptiveFixture()
+            : arbiter(errorPolicy, config())
+        {
+        }
+
+        static arbiter::HistoryConfig config()
+        {
+            arbiter::HistoryConfig config(2, 4096);
+            config.maxHistoryDepth = Depth;
+            config.lagPercentile = 0.99;
+
+            return config;
+        }
+
+        typename DynamicTraits<2, Depth>::ErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<DynamicTraits<2, Depth>> arbiter;
+    };
+
+    template<std::size_t Depth>
+    std::unique_ptr<AdaptiveFixture<Depth>> makeAdaptiveFixture()
+    {
+        return std::unique_ptr<AdaptiveFixture<Depth>>(new AdaptiveFixture<Depth>());
+    }
+
+    template<std::size_t Depth>
+    void measureAdaptive(const std::string& name, const std::vector<LineProfile>& profiles)
+    {
+        const auto feed = interleavedFeed(profiles, Sequences);
+
+        measureArbiter<DynamicTraits<2, Depth>>(name + "_Fixed", feed, Tag::Mixed);
+        measure(benchmarkName(name + "_Adaptive", 2, Depth), feed, &makeAdaptiveFixture<Depth>,
+            [](AdaptiveFixture<Depth>& fixture, const Message& message) { return fixture.arbiter.validate(message.line, message.sequence); },
+            [](const Message& message) { return message.tag == Tag::Mixed; });
+    }
+
+    template<std::size_t Depth>
+    void measureDynamic(const std::string& name, const std::vector<LineProfile>& profiles)
+    {
+        const auto feed = interleavedFeed(profiles, Sequences);
+
+        measureArbiter<ColumnTraits<2, Depth>>(name + "_SoA", feed, Tag::Mixed);
+        measureArbiter<DynamicTraits<2, Depth>>(name + "_Dynamic", feed, Tag::Mixed);
+        measureArbiter<DynamicTraits<2, Depth - 1>>(name + "_Dynamic_Modulo", feed, Tag::Mixed);
+    }
+
+    BENCHMARK(DynamicHistory)
+    {
+        measureDynamic<4096>("Dynamic_AB_Lagging", {{0, 0.5, 0.01}, {1024, 4, 0.01}});
+        measureDynamic<1 << 16>("Dynamic_AB_Lagging", {{0, 0.5, 0.01}, {16384, 4, 0.01}});
+        measureDynamic<1 << 20>("Dynamic_AB_Lagging", {{0, 0.5, 0.01}, {262144, 4, 0.01}});
+
+        measureAdaptive<1 << 20>("Dynamic_AB_Lagging", {{0, 0.5, 0.01}, {1024, 4, 0.01}});
+    }
+}
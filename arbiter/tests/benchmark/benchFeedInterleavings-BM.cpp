@@ -0,0 +1,48 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// end to end ns/message for realistic multi-line feeds with jitter and loss.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Sequences = 1 << 20;
+
+    template<std::size_t Lines, std::size_t Depth>
+    void measureFeed(const std::string& name, const std::vector<LineProfile>& profiles)
+    {
+        measureArbiter<Lines, Depth>(name, interleavedFeed(profiles, Sequences), Tag::Mixed);
+    }
+
+    BENCHMARK(FeedInterleavings)
+    {
+        // A/B lines with the same latency, small jitter, no loss.
+        measureFeed<2, 4096>("Feed_AB_Balanced", {{0, 0.5, 0}, {0, 0.5, 0}});
+
+        // B trails A by ~50 messages.
+        measureFeed<2, 4096>("Feed_AB_Skewed", {{0, 0.5, 0}, {50, 0.5, 0}});
+
+        // both lines lossy, A worse than B.
+        measureFeed<2, 4096>("Feed_AB_Lossy", {{0, 0.5, 0.01}, {2, 0.5, 0.001}});
+
+        // bursty jitter, the lead line flips often.
+        measureFeed<2, 4096>("Feed_AB_Jittery", {{0, 8, 0.001}, {0, 8, 0.001}});
+
+        // B is degraded, most overwritten history slots are missing line B.
+        measureFeed<2, 4096>("Feed_AB_DegradedLine", {{0, 0.5, 0}, {1, 0.5, 0.5}});
+
+        measureFeed<4, 4096>("Feed_4Lines_Lossy", {{0, 0.5, 0.01}, {1, 1, 0.01}, {5, 2, 0.005}, {20, 4, 0.02}});
+
+        std::vector<LineProfile> sixteen;
+        for(std::size_t line = 0; line < 16; ++line)
+        {
+            sixteen.push_back(LineProfile{static_cast<double>(line), 1.0 + static_cast<double>(line % 4), 0.001 * static_cast<double>(line % 3)});
+        }
+
+        measureFeed<16, 65536>("Feed_16Lines_Lossy", sixteen);
+    }
+}
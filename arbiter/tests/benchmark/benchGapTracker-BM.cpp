@@ -0,0 +1,131 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <arbiter/GapTracker.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// cost of following open gaps on a lossy A/B feed: the plain arbiter, GapTracker and a policy
+// keeping the missing sequence numbers in a std::map, every PollEvery'th message also polls
+// for retransmission requests. Samples every message.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Lines = 2;
+    constexpr std::size_t Depth = 4096;
+    constexpr std::size_t Sequences = 1 << 20;
+    constexpr std::size_t PollEvery = 64;
+
+    using Tracker = arbiter::GapTracker<std::size_t>;
+
+    arbiter::RetransmissionConfig Config() { return arbiter::RetransmissionConfig(0, 1 << 20, 8); }
+
+    // one entry per missing sequence number, requested once.
+    struct MapPolicy : public arbiter::details::NullErrorReportingPolicy<std::size_t>
+    {
+        void Gap(const std::size_t start, const std::size_t length) { for(std::size_t i = 0; i < length; ++i) missing.emplace(start + i, false); }
+        void GapFill(const std::size_t start, const std::size_t) { missing.erase(start); }
+        void UnrecoverableGap(const std::size_t start, const std::size_t length = 1) { for(std::size_t i = 0; i < length; ++i) missing.erase(start + i); }
+
+        template<class Request>
+        std::size_t requestRetransmissions(Request&& request)
+        {
+            std::size_t requests = 0;
+            for(auto& entry : missing)
+            {
+                if(!entry.second)
+                {
+                    entry.second = true;
+                    request(entry.first, 1);
+                    ++requests;
+                }
+            }
+
+            return requests;
+        }
+
+        std::map<std::size_t, bool> missing;
+    };
+
+    struct TrackerTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        using ErrorReportingPolicy = Tracker;
+    };
+
+    struct MapTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        using ErrorReportingPolicy = MapPolicy;
+    };
+
+    struct TrackerFixture
+    {
+        TrackerFixture()
+            : tracker(Tracker::capacity(Depth, Config()), Config())
+            , arbiter(tracker)
+        {
+        }
+
+        Tracker tracker;
+        arbiter::SequenceArbiter<TrackerTraits> arbiter;
+        std::uint64_t now = 0;
+    };
+
+    std::unique_ptr<TrackerFixture> makeTrackerFixture()
+    {
+        return std::unique_ptr<TrackerFixture>(new TrackerFixture());
+    }
+
+    bool polls(const Message& message)
+    {
+        return (message.sequence % PollEvery) == 0;
+    }
+
+    void measureGapTracker(const std::string& name, const std::vector<LineProfile>& profiles)
+    {
+        const auto feed = interleavedFeed(profiles, Sequences);
+        const auto all = [](const Message&) { return true; };
+
+        measure(benchmarkName(name + "_Null", Lines, Depth), feed, &makeArbiter<BenchmarkTraits<Lines, Depth>>, &validate<BenchmarkTraits<Lines, Depth>>, all);
+
+        measure(benchmarkName(name + "_Map", Lines, Depth), feed, &makeArbiter<MapTraits>,
+            [](ArbiterFixture<MapTraits>& fixture, const Message& message)
+            {
+                std::size_t accept = fixture.arbiter.validate(message.line, message.sequence);
+                if(polls(message))
+                {
+                    accept += fixture.errorPolicy.requestRetransmissions([](const std::size_t, const std::size_t) {});
+                }
+
+                return accept;
+            }, all);
+
+        measure(benchmarkName(name + "_GapTracker", Lines, Depth), feed, &makeTrackerFixture,
+            [](TrackerFixture& fixture, const Message& message)
+            {
+                std::size_t accept = fixture.arbiter.validate(message.line, message.sequence);
+                if(polls(message))
+                {
+                    accept += fixture.tracker.requestRetransmissions(++fixture.now, [](const std::size_t, const std::size_t) {});
+                }
+
+                return accept;
+            }, all);
+    }
+
+    BENCHMARK(GapTracker)
+    {
+        // B trails A and both drop messages, most gaps are filled by the other line.
+        measureGapTracker("GapTracker_AB_Lossy", {{0, 0.5, 0.01}, {20, 0.5, 0.01}});
+
+        // B is down, every message A drops stays open.
+        measureGapTracker("GapTracker_A_Lossy", {{0, 0.5, 0.02}, {1e9, 0, 1.0}});
+    }
+}
@@ -0,0 +1,60 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <arbiter/HistoryLayout.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ArrayOfStructures vs StructureOfArrays vs ImplicitSequence history for histories larger than L1/L2,
+// where the lagging line touches slots far behind the lead line.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Sequences = 1 << 21;
+
+    template<std::size_t Lines, std::size_t Depth>
+    struct ColumnTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::StructureOfArrays; }
+    };
+
+    template<std::size_t Lines, std::size_t Depth>
+    struct ImplicitTraits : public BenchmarkTraits<Lines, Depth>
+    {
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::ImplicitSequence; }
+    };
+
+    template<class Traits>
+    std::string layoutName(const std::string& name)
+    {
+        using History = typename arbiter::details::ArbiterCache<Traits>::History;
+        return name + "/bytes:" + std::to_string(sizeof(History));
+    }
+
+    template<std::size_t Lines, std::size_t Depth>
+    void measureLayouts(const std::string& name, const std::vector<LineProfile>& profiles)
+    {
+        const auto feed = interleavedFeed(profiles, Sequences);
+
+        measureArbiter<BenchmarkTraits<Lines, Depth>>(layoutName<BenchmarkTraits<Lines, Depth>>(name + "_AoS"), feed, Tag::Mixed);
+        measureArbiter<ColumnTraits<Lines, Depth>>(layoutName<ColumnTraits<Lines, Depth>>(name + "_SoA"), feed, Tag::Mixed);
+        measureArbiter<ImplicitTraits<Lines, Depth>>(layoutName<ImplicitTraits<Lines, Depth>>(name + "_Implicit"), feed, Tag::Mixed);
+    }
+
+    BENCHMARK(HistoryLayout)
+    {
+        // B trails A by a quarter of the history, both lines are lossy.
+        measureLayouts<2, 4096>("Layout_AB_Lagging", {{0, 0.5, 0.01}, {1024, 4, 0.01}});
+        measureLayouts<2, 1 << 16>("Layout_AB_Lagging", {{0, 0.5, 0.01}, {16384, 4, 0.01}});
+        measureLayouts<2, 1 << 20>("Layout_AB_Lagging", {{0, 0.5, 0.01}, {262144, 4, 0.01}});
+
+        // four lines spread across half of the history.
+        measureLayouts<4, 1 << 20>("Layout_4Lines_Spread", {{0, 0.5, 0.01}, {65536, 2, 0.01}, {262144, 4, 0.01}, {524288, 8, 0.01}});
+
+        measureLayouts<2, 1 << 22>("Layout_AB_Lagging", {{0, 0.5, 0.01}, {1048576, 4, 0.01}});
+    }
+}
@@ -0,0 +1,95 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <arbiter/MultiStreamSequenceArbiter.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+// many channels with A/B lines, MultiStreamSequenceArbiter vs a hash map of SequenceArbiters.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Channels = 256;
+    constexpr std::size_t Sequences = 1 << 14;
+
+    using Traits = BenchmarkTraits<2, 1024>;
+
+    // message i of the lockstep feed goes to channel (i / 2) % Channels, channel ids are sparse.
+    inline std::size_t channelOf(const std::size_t index) { return 1000 + 7919 * ((index / 2) % Channels); }
+
+    inline Feed channelFeed()
+    {
+        Feed feed;
+        feed.reserve(2 * Channels * Sequences);
+
+        for(std::size_t sequence = 0; sequence < Sequences; ++sequence)
+        {
+            for(std::size_t channel = 0; channel < Channels; ++channel)
+            {
+                feed.push_back(Message{0, sequence, Tag::AdvanceHead});
+                feed.push_back(Message{1, sequence, Tag::AdvanceLine});
+            }
+        }
+
+        return feed;
+    }
+
+    struct MultiStreamFixture
+    {
+        MultiStreamFixture()
+            : arbiter(errorPolicy, Channels)
+            , index(0)
+        {
+            for(std::size_t channel = 0; channel < Channels; ++channel)
+            {
+                arbiter.addStream(channelOf(2 * channel));
+            }
+        }
+
+        Traits::ErrorReportingPolicy errorPolicy;
+        arbiter::MultiStreamSequenceArbiter<Traits> arbiter;
+        std::size_t index;
+    };
+
+    struct HashMapFixture
+    {
+        HashMapFixture()
+            : index(0)
+        {
+            for(std::size_t channel = 0; channel < Channels; ++channel)
+            {
+                arbiters.emplace(channelOf(2 * channel), std::unique_ptr<arbiter::SequenceArbiter<Traits>>(new arbiter::SequenceArbiter<Traits>(errorPolicy)));
+            }
+        }
+
+        Traits::ErrorReportingPolicy errorPolicy;
+        std::unordered_map<std::size_t, std::unique_ptr<arbiter::SequenceArbiter<Traits>>> arbiters;
+        std::size_t index;
+    };
+
+    BENCHMARK(MultiStream)
+    {
+        const auto feed = channelFeed();
+        const auto name = benchmarkName("Channels_" + std::to_string(Channels), Traits::NumberOfLines(), Traits::HistoryDepth());
+
+        measure(name + "/MultiStream", feed,
+            []() { return std::unique_ptr<MultiStreamFixture>(new MultiStreamFixture()); },
+            [](MultiStreamFixture& fixture, const Message& message)
+            {
+                return fixture.arbiter.validate(channelOf(fixture.index++), message.line, message.sequence);
+            },
+            [](const Message&) { return true; });
+
+        measure(name + "/HashMap", feed,
+            []() { return std::unique_ptr<HashMapFixture>(new HashMapFixture()); },
+            [](HashMapFixture& fixture, const Message& message)
+            {
+                return fixture.arbiters.find(channelOf(fixture.index++))->second->validate(message.line, message.sequence);
+            },
+            [](const Message&) { return true; });
+    }
+}
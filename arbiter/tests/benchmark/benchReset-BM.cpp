@@ -0,0 +1,51 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <cstddef>
+#include <memory>
+
+// cost of SequenceArbiter::reset() against history depth, clearing vs epoch reset.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Sequences = 1 << 16;
+    constexpr std::size_t ResetEvery = 1024;
+
+    template<std::size_t Depth>
+    struct EpochResetTraits : public BenchmarkTraits<2, Depth>
+    {
+        static constexpr bool EpochReset() { return true; }
+    };
+
+    // validate then reset on every ResetEvery'th message, sampling the resets.
+    template<class Traits>
+    void measureReset(const std::string& name)
+    {
+        auto feed = lockstepFeed(Traits::NumberOfLines(), Sequences);
+
+        measure(benchmarkName(name, Traits::NumberOfLines(), Traits::HistoryDepth()), feed,
+            &makeArbiter<Traits>,
+            [](ArbiterFixture<Traits>& fixture, const Message& message)
+            {
+                auto accept = fixture.arbiter.validate(message.line, message.sequence % ResetEvery);
+                if((message.line == 0) && ((message.sequence % ResetEvery) == ResetEvery - 1))
+                {
+                    fixture.arbiter.reset();
+                }
+
+                return accept;
+            },
+            [](const Message& message) { return (message.line == 0) && ((message.sequence % ResetEvery) == ResetEvery - 1); });
+    }
+
+    BENCHMARK(Reset)
+    {
+        measureReset<BenchmarkTraits<2, 4096>>("Reset_Clear");
+        measureReset<BenchmarkTraits<2, 1 << 20>>("Reset_Clear");
+
+        measureReset<EpochResetTraits<4096>>("Reset_Epoch");
+        measureReset<EpochResetTraits<1 << 20>>("Reset_Epoch");
+    }
+}
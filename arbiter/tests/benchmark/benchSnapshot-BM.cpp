@@ -0,0 +1,82 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// cost of checkpointing a SequenceArbiter with snapshot() into the same buffer against history
+// depth, every CheckpointEvery'th message validates then snapshots, sampling the checkpoints.
+// Whole snapshots compare every slot, incremental ones only those changed since the last.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Sequences = 1 << 16;
+    constexpr std::size_t CheckpointEvery = 1024;
+
+    template<class Traits>
+    struct IncrementalTraits : public Traits
+    {
+        static constexpr bool IncrementalSnapshots() { return true; }
+    };
+
+    template<class Traits>
+    struct SnapshotFixture : public ArbiterFixture<Traits>
+    {
+        SnapshotFixture()
+            : buffer(this->arbiter.snapshotSize())
+        {
+            this->arbiter.snapshot(buffer.data());
+        }
+
+        std::vector<unsigned char> buffer;
+    };
+
+    template<class Traits>
+    std::unique_ptr<SnapshotFixture<Traits>> makeSnapshotFixture()
+    {
+        return std::unique_ptr<SnapshotFixture<Traits>>(new SnapshotFixture<Traits>());
+    }
+
+    bool checkpoints(const Message& message)
+    {
+        return (message.line == 0) && ((message.sequence % CheckpointEvery) == CheckpointEvery - 1);
+    }
+
+    // @lines of the arbiter's lines carry the feed, the others are down and overrun by head.
+    template<class Traits>
+    void measureSnapshot(const std::string& name, const std::size_t lines = Traits::NumberOfLines())
+    {
+        auto feed = lockstepFeed(lines, Sequences);
+
+        measure(benchmarkName(name, Traits::NumberOfLines(), Traits::HistoryDepth()), feed,
+            &makeSnapshotFixture<Traits>,
+            [](SnapshotFixture<Traits>& fixture, const Message& message)
+            {
+                auto accept = fixture.arbiter.validate(message.line, message.sequence);
+                if(checkpoints(message))
+                {
+                    fixture.arbiter.snapshot(fixture.buffer.data());
+                }
+
+                return accept;
+            },
+            &checkpoints);
+    }
+
+    BENCHMARK(Snapshot)
+    {
+        measureSnapshot<BenchmarkTraits<2, 4096>>("Snapshot_Checkpoint");
+        measureSnapshot<BenchmarkTraits<2, 1 << 16>>("Snapshot_Checkpoint");
+        measureSnapshot<BenchmarkTraits<8, 4096>>("Snapshot_Checkpoint");
+        measureSnapshot<BenchmarkTraits<2, 1 << 16>>("Snapshot_Checkpoint_LineDown", 1);
+
+        measureSnapshot<IncrementalTraits<BenchmarkTraits<2, 4096>>>("Snapshot_IncrementalCheckpoint");
+        measureSnapshot<IncrementalTraits<BenchmarkTraits<2, 1 << 16>>>("Snapshot_IncrementalCheckpoint");
+        measureSnapshot<IncrementalTraits<BenchmarkTraits<8, 4096>>>("Snapshot_IncrementalCheckpoint");
+        measureSnapshot<IncrementalTraits<BenchmarkTraits<2, 1 << 16>>>("Snapshot_IncrementalCheckpoint_LineDown", 1);
+    }
+}
@@ -0,0 +1,103 @@
+#include "./platform/BenchmarkSupport.hpp"
+#include "./ArbiterFixture.hpp"
+#include "./FeedGenerator.hpp"
+
+#include <arbiter/AcceptedIntervals.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// arbitration cost of a packet of consecutive sequence numbers: validate() per message, validateBatch()
+// and validateRange() writing AcceptedIntervals. Line 1 packetizes @offset messages behind line 0, so
+// each of its packets repeats part of line 0's packet and carries the start of the next one.
+// Each feed message is one packet, latencies are per packet.
+namespace {
+
+    using namespace benchmark;
+
+    constexpr std::size_t Lines = 2;
+    constexpr std::size_t Depth = 4096;
+    constexpr std::size_t Packets = 1 << 12;
+
+    using Traits = BenchmarkTraits<Lines, Depth>;
+
+    template<std::size_t PacketSize>
+    Feed packetFeed(const std::size_t offset)
+    {
+        Feed feed;
+        feed.reserve(Lines * Packets);
+
+        for(std::size_t packet = 0; packet < Packets; ++packet)
+        {
+            feed.push_back(Message{0, packet * PacketSize, Tag::AdvanceHead});
+            feed.push_back(Message{1, packet * PacketSize + offset, Tag::AdvanceLine});
+        }
+
+        return feed;
+    }
+
+    template<std::size_t PacketSize>
+    std::string packetName(const std::string& name, const std::size_t offset)
+    {
+        return benchmarkName(name, Lines, Depth) + "/packet:" + std::to_string(PacketSize) + "/offset:" + std::to_string(offset);
+    }
+
+    template<std::size_t PacketSize>
+    struct PacketFixture : public ArbiterFixture<Traits>
+    {
+        std::size_t sequences[PacketSize];
+        bool accept[PacketSize];
+
+        arbiter::AcceptedIntervals<std::size_t> intervals;
+    };
+
+    template<std::size_t PacketSize>
+    std::unique_ptr<PacketFixture<PacketSize>> makePacketFixture()
+    {
+        return std::unique_ptr<PacketFixture<PacketSize>>(new PacketFixture<PacketSize>());
+    }
+
+    template<std::size_t PacketSize>
+    void measurePackets(const std::size_t offset)
+    {
+        const auto feed = packetFeed<PacketSize>(offset);
+        const auto all = [](const Message&) { return true; };
+
+        measure(packetName<PacketSize>("ValidateRange_PerMessage", offset), feed, &makePacketFixture<PacketSize>,
+            [](PacketFixture<PacketSize>& fixture, const Message& message)
+            {
+                std::size_t accepted = 0;
+                for(std::size_t i = 0; i < PacketSize; ++i)
+                {
+                    accepted += fixture.arbiter.validate(message.line, message.sequence + i);
+                }
+
+                return accepted;
+            }, all);
+
+        measure(packetName<PacketSize>("ValidateRange_Batch", offset), feed, &makePacketFixture<PacketSize>,
+            [](PacketFixture<PacketSize>& fixture, const Message& message)
+            {
+                for(std::size_t i = 0; i < PacketSize; ++i)
+                {
+                    fixture.sequences[i] = message.sequence + i;
+                }
+
+                return fixture.arbiter.validateBatch(message.line, fixture.sequences, PacketSize, fixture.accept);
+            }, all);
+
+        measure(packetName<PacketSize>("ValidateRange_Intervals", offset), feed, &makePacketFixture<PacketSize>,
+            [](PacketFixture<PacketSize>& fixture, const Message& message)
+            {
+                return fixture.arbiter.validateRange(message.line, message.sequence, PacketSize, fixture.intervals);
+            }, all);
+    }
+
+    BENCHMARK(ValidateRange)
+    {
+        measurePackets<8>(4);
+        measurePackets<50>(20);
+        measurePackets<200>(120);
+    }
+}
@@ -0,0 +1,8 @@
+#include "./platform/BenchmarkSupport.hpp"
+
+// usage: arbiter-Bench [filter]
+// runs every benchmark group whose name contains filter.
+int main(int argc, char** argv)
+{
+    return benchmark::RunAllBenchmarks(argc, argv);
+}
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BENCHMARK_HAS_TSC
+#endif
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cstring>
+    #define BENCHMARK_HAS_PERF_EVENTS
+#endif
+
+// A small, dependency free benchmark harness in the style of Google Benchmark.
+// Each benchmark replays a feed of messages twice against a fresh fixture:
+//  - once untimed per message to measure throughput of the whole feed.
+//  - once timing every message to build a latency distribution for the
+//    messages selected by the benchmark (e.g. only those hitting one state).
+namespace benchmark {
+
+    using Clock = std::chrono::steady_clock;
+
+    // cheap per message timestamps, the TSC where we have one.
+    inline std::uint64_t ticks()
+    {
+#ifdef BENCHMARK_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    inline double nanosPerTick()
+    {
+        static const double ratio = []
+        {
+#ifdef BENCHMARK_HAS_TSC
+            auto startTime = Clock::now();
+            auto startTicks = ticks();
+
+            while(Clock::now() - startTime < std::chrono::milliseconds(50))
+            {
+            }
+
+            auto elapsedTicks = ticks() - startTicks;
+            auto elapsedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+
+            return static_cast<double>(elapsedNanos) / static_cast<double>(elapsedTicks);
+#else
+            return 1.0;
+#endif
+        }();
+
+        return ratio;
+    }
+
+    // keep the compiler from discarding a value we computed.
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    // counts branch misses of this thread with perf_event_open(2), where the kernel allows it
+    // (see /proc/sys/kernel/perf_event_paranoid). Reports -1 when counting isn't available.
+    class BranchMissCounter
+    {
+    public:
+        BranchMissCounter()
+            : fd_(-1)
+        {
+#ifdef BENCHMARK_HAS_PERF_EVENTS
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        ~BranchMissCounter()
+        {
+#ifdef BENCHMARK_HAS_PERF_EVENTS
+            if(fd_ != -1)
+            {
+                close(fd_);
+            }
+#endif
+        }
+
+        BranchMissCounter(const BranchMissCounter&) = delete;
+        BranchMissCounter& operator=(const BranchMissCounter&) = delete;
+
+        void start()
+        {
+#ifdef BENCHMARK_HAS_PERF_EVENTS
+            if(fd_ != -1)
+            {
+                control(PERF_EVENT_IOC_RESET);
+                control(PERF_EVENT_IOC_ENABLE);
+            }
+#endif
+        }
+
+        // branch misses since start(), -1 if unavailable.
+        double stop()
+        {
+#ifdef BENCHMARK_HAS_PERF_EVENTS
+            std::uint64_t count = 0;
+            if((fd_ != -1) && control(PERF_EVENT_IOC_DISABLE) && (read(fd_, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))))
+            {
+                return static_cast<double>(count);
+            }
+#endif
+            return -1;
+        }
+
+    private:
+#ifdef BENCHMARK_HAS_PERF_EVENTS
+        bool control(const unsigned long request)
+        {
+            return ::ioctl(fd_, request, 0) != -1;
+        }
+#endif
+
+        int fd_;
+    };
+
+    struct Result
+    {
+        std::string name;
+
+        std::size_t messages;           // messages in the feed
+        std::size_t sampled;            // messages included in the latency distribution
+
+        double feedNanosPerMessage;     // wall clock for the whole feed / messages
+        double branchMissesPerMessage;  // over the whole feed, negative when not counted
+        double meanNanos;               // mean latency of the sampled messages
+        double p50;
+        double p99;
+        double p999;
+    };
+
+    class Registry
+    {
+    public:
+        using Benchmark = std::function<void()>;
+
+        static Registry& instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        void add(const std::string& group, Benchmark benchmark)
+        {
+            benchmarks_.emplace_back(group, std::move(benchmark));
+        }
+
+        // run every benchmark group containing @filter (all when @filter is empty)
+        int run(const std::string& filter)
+        {
+            std::printf("%-58s %10s %10s %8s %8s %8s %8s %10s %8s\n", "Benchmark", "messages", "feed ns", "mean", "p50", "p99", "p999", "Mmsg/s", "br-miss");
+            std::printf("%s\n", std::string(137, '-').c_str());
+
+            for(auto& benchmark : benchmarks_)
+            {
+                if(filter.empty() || (benchmark.first.find(filter) != std::string::npos))
+                {
+                    benchmark.second();
+                }
+            }
+
+            return 0;
+        }
+
+        static void report(const Result& result)
+        {
+            char branchMisses[16] = "-";
+            if(result.branchMissesPerMessage >= 0)
+            {
+                std::snprintf(branchMisses, sizeof(branchMisses), "%.4f", result.branchMissesPerMessage);
+            }
+
+            std::printf("%-58s %10zu %10.2f %8.2f %8.1f %8.1f %8.1f %10.2f %8s\n",
+                result.name.c_str(),
+                result.messages,
+                result.feedNanosPerMessage,
+                result.meanNanos,
+                result.p50,
+                result.p99,
+                result.p999,
+                result.feedNanosPerMessage > 0 ? 1000.0 / result.feedNanosPerMessage : 0.0,
+                branchMisses);
+
+            std::fflush(stdout);
+        }
+
+    private:
+        std::vector<std::pair<std::string, Benchmark>> benchmarks_;
+    };
+
+    struct Registrar
+    {
+        Registrar(const std::string& group, Registry::Benchmark benchmark)
+        {
+            Registry::instance().add(group, std::move(benchmark));
+        }
+    };
+
+    // the cost of taking a timestamp (in ticks), subtracted from every latency sample.
+    inline double clockOverhead()
+    {
+        static const double overhead = []
+        {
+            std::vector<std::uint64_t> samples(10000);
+            for(auto& sample : samples)
+            {
+                auto start = ticks();
+                auto end = ticks();
+                sample = end - start;
+            }
+
+            std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+            return static_cast<double>(samples[samples.size() / 2]);
+        }();
+
+        return overhead;
+    }
+
+    inline double percentile(std::vector<double>& samples, const double fraction)
+    {
+        if(samples.empty())
+        {
+            return 0;
+        }
+
+        auto index = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+        return samples[index];
+    }
+
+    // Replay @feed against fixtures built by @make().
+    // @process(fixture, message) handles one message and returns a value we keep alive,
+    // @sample(message) selects the messages included in the latency distribution.
+    template<class Feed, class Make, class Process, class Sample>
+    Result measure(const std::string& name, const Feed& feed, Make make, Process process, Sample sample)
+    {
+        Result result;
+        result.name = name;
+        result.messages = feed.size();
+
+        {
+            auto fixture = make();
+            BranchMissCounter branchMisses;
+
+            branchMisses.start();
+            auto start = Clock::now();
+            for(const auto& message : feed)
+            {
+                DoNotOptimize(process(*fixture, message));
+            }
+            auto end = Clock::now();
+            const auto misses = branchMisses.stop();
+
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            result.feedNanosPerMessage = feed.empty() ? 0 : static_cast<double>(elapsed) / static_cast<double>(feed.size());
+            result.branchMissesPerMessage = (feed.empty() || misses < 0) ? -1 : misses / static_cast<double>(feed.size());
+        }
+
+        std::vector<double> latencies;
+        latencies.reserve(feed.size());
+
+        {
+            auto fixture = make();
+
+            const auto overhead = clockOverhead();
+            const auto ratio = nanosPerTick();
+
+            for(const auto& message : feed)
+            {
+                auto start = ticks();
+                DoNotOptimize(process(*fixture, message));
+                auto end = ticks();
+
+                if(sample(message))
+                {
+                    auto elapsed = static_cast<double>(end - start) - overhead;
+                    latencies.push_back(elapsed < 0 ? 0 : elapsed * ratio);
+                }
+            }
+        }
+
+        result.sampled = latencies.size();
+
+        double total = 0;
+        for(auto latency : latencies)
+        {
+            total += latency;
+        }
+
+        result.meanNanos = latencies.empty() ? 0 : total / static_cast<double>(latencies.size());
+        result.p50 = percentile(latencies, 0.50);
+        result.p99 = percentile(latencies, 0.99);
+        result.p999 = percentile(latencies, 0.999);
+
+        Registry::report(result);
+        return result;
+    }
+
+    inline int RunAllBenchmarks(int argc, char** argv)
+    {
+        return Registry::instance().run(argc > 1 ? argv[1] : "");
+    }
+}
+
+#define BENCHMARK_CONCATENATE_DETAIL(x, y) x##y
+#define BENCHMARK_CONCATENATE(x, y) BENCHMARK_CONCATENATE_DETAIL(x, y)
+
+// register a benchmark group, the body runs one or more benchmark::measure() calls.
+#define BENCHMARK(Group) \
+    static void Group(); \
+    static benchmark::Registrar BENCHMARK_CONCATENATE(Group, Registrar)(#Group, &Group); \
+    static void Group()
@@ -0,0 +1,139 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/details/ArbiterCache.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+
+namespace {
+
+    template<bool Epoch>
+    struct FillTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 5; }
+        static constexpr bool EpochReset() { return Epoch; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = arbiter::details::NullErrorReportingPolicy<std::size_t>;
+    };
+
+    template<class Traits>
+    void verifyFillGapWrapsAroundHistory()
+    {
+        arbiter::details::ArbiterCache<Traits> cache;
+
+        const std::size_t next = cache.fillGap(3, 10, 4);
+        CHECK_EQUAL(2U, next);
+
+        CHECK_EQUAL(10U, cache.history[3].sequence());
+        CHECK_EQUAL(11U, cache.history[4].sequence());
+        CHECK_EQUAL(12U, cache.history[0].sequence());
+        CHECK_EQUAL(13U, cache.history[1].sequence());
+
+        for(const std::size_t position : {3U, 4U, 0U, 1U})
+        {
+            CHECK(cache.history[position].empty());
+        }
+
+        // untouched slot
+        CHECK_EQUAL(0U, cache.history[2].sequence());
+        CHECK(cache.history[2].complete());
+    }
+
+    template<class Traits>
+    void verifyFillGapLongerThanHistoryKeepsLastSlots()
+    {
+        arbiter::details::ArbiterCache<Traits> cache;
+
+        // 12 slots written from position 1 end at position 3, only the
+        // 4 slots preceding it survive.
+        const std::size_t next = cache.fillGap(1, 20, 12);
+        CHECK_EQUAL(3U, next);
+
+        CHECK_EQUAL(28U, cache.history[4].sequence());
+        CHECK_EQUAL(29U, cache.history[0].sequence());
+        CHECK_EQUAL(30U, cache.history[1].sequence());
+        CHECK_EQUAL(31U, cache.history[2].sequence());
+    }
+
+    TEST(verifyArbiterCacheFillGapWrapsAroundHistory)
+    {
+        verifyFillGapWrapsAroundHistory<FillTraits<false>>();
+        verifyFillGapWrapsAroundHistory<FillTraits<true>>();
+    }
+
+    TEST(verifyArbiterCacheFillGapLongerThanHistoryKeepsLastSlots)
+    {
+        verifyFillGapLongerThanHistoryKeepsLastSlots<FillTraits<false>>();
+        verifyFillGapLongerThanHistoryKeepsLastSlots<FillTraits<true>>();
+    }
+
+    TEST(verifyArbiterCacheFillGapOfZeroIsNoOp)
+    {
+        arbiter::details::ArbiterCache<FillTraits<false>> cache;
+
+        CHECK_EQUAL(4U, cache.fillGap(4, 7, 0));
+        CHECK_EQUAL(0U, cache.history[4].sequence());
+        CHECK(cache.history[4].complete());
+    }
+
+    struct PowerOfTwoTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 4; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 8; }
+        static constexpr bool PowerOfTwoHistoryDepth() { return true; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = arbiter::details::NullErrorReportingPolicy<std::size_t>;
+    };
+
+    TEST(verifyArbiterCacheWrapsWithMaskForPowerOfTwoDepth)
+    {
+        using Cache = arbiter::details::ArbiterCache<PowerOfTwoTraits>;
+
+        CHECK(Cache::MaskedWrap);
+        CHECK(!arbiter::details::ArbiterCache<FillTraits<false>>::MaskedWrap);
+
+        Cache cache;
+        CHECK_EQUAL(0U, cache.wrap(0));
+        CHECK_EQUAL(7U, cache.wrap(7));
+        CHECK_EQUAL(0U, cache.wrap(8));
+        CHECK_EQUAL(3U, cache.wrap(19));
+
+        arbiter::details::ArbiterCache<FillTraits<false>> moduloCache;
+        CHECK_EQUAL(4U, moduloCache.wrap(9));
+    }
+
+    struct FourLineTraits : public PowerOfTwoTraits
+    {
+        static constexpr std::size_t NumberOfLines() { return 4; }
+    };
+
+    TEST(verifyArbiterCacheCountsSlotsBeforeTheSlowestLine)
+    {
+        arbiter::details::ArbiterCache<FourLineTraits> cache;
+
+        cache.head = 0;
+        cache.positions = {{5, 3, 4, 5}};
+
+        // 2 slots behind head, line 1 is 5 slots ahead of head's writes.
+        CHECK(!cache.mayOverrun(2));
+        CHECK(!cache.mayOverrun(3));
+
+        cache.positions[0] = 2;
+        CHECK(cache.mayOverrun(1));     // the next slot is line 1's
+
+        // line 1 catches up, line 2 is now the slowest.
+        cache.positions[1] = 2;
+        CHECK(!cache.mayOverrun(1));
+        CHECK(cache.mayOverrun(2));     // head hasn't moved, line 2's slot is the second one on
+
+        // line 2 as head, line 3 is in the slot after it.
+        cache.head = 2;
+        CHECK(cache.mayOverrun(1));
+    }
+}
@@ -0,0 +1,188 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/ArbiterStage.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    class CountingErrorReportingPolicy : public arbiter::details::NullErrorReportingPolicy<std::size_t>
+    {
+    public:
+        void Gap(const std::size_t, const std::size_t) { ++gaps; }
+
+        std::size_t gaps = 0;
+    };
+
+    struct StageTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 50; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 128; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = CountingErrorReportingPolicy;
+    };
+
+    using Stage = arbiter::ArbiterStage<StageTraits, const char*>;
+
+    class CountingErrorReportingPolicy16 : public arbiter::details::NullErrorReportingPolicy<std::uint16_t>
+    {
+    public:
+        void Gap(const std::uint16_t, const std::uint16_t) { ++gaps; }
+        void GapFill(const std::uint16_t, const std::uint16_t) { ++gapFills; }
+
+        std::size_t gaps = 0;
+        std::size_t gapFills = 0;
+    };
+
+    struct SerialStageTraits
+    {
+        static constexpr std::uint16_t FirstExpectedSequenceNumber() { return 65533; }
+        static constexpr std::size_t LargestRecoverableGap() { return 50; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 128; }
+        static constexpr bool SerialNumberArithmetic() { return true; }
+
+        using SequenceType = std::uint16_t;
+        using ErrorReportingPolicy = CountingErrorReportingPolicy16;
+    };
+
+    TEST(verifyArbiterStageDrainsLowestSequenceFirst)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        Stage stage(errorPolicy, 8);
+
+        const char* payloads[] = {"a0", "a1", "a2", "b0", "b1", "b2"};
+
+        // line 0's thread ran ahead, line 1 queued what line 0 is missing.
+        CHECK(stage.push(0, 0, payloads[0]));
+        CHECK(stage.push(0, 2, payloads[2]));
+        CHECK(stage.push(1, 0, payloads[3]));
+        CHECK(stage.push(1, 1, payloads[4]));
+        CHECK(stage.push(1, 2, payloads[5]));
+
+        std::vector<std::size_t> sequences;
+        std::vector<const char*> handles;
+        std::size_t rejected = 0;
+
+        CHECK_EQUAL(5U, stage.drain(
+            [&](const std::size_t, const std::size_t sequence, const char* handle) { sequences.push_back(sequence); handles.push_back(handle); },
+            [&](const std::size_t, const std::size_t, const char*) { ++rejected; }));
+
+        REQUIRE CHECK_EQUAL(3U, sequences.size());
+        CHECK_EQUAL(0U, sequences[0]);
+        CHECK_EQUAL(1U, sequences[1]);
+        CHECK_EQUAL(2U, sequences[2]);
+        CHECK_EQUAL(payloads[4], handles[1]);     // the handle, not a copy of the payload
+
+        CHECK_EQUAL(2U, rejected);
+        CHECK_EQUAL(0U, errorPolicy.gaps);        // 2 was never seen before 1
+
+        CHECK_EQUAL(0U, stage.drain([](std::size_t, std::size_t, const char*) {}, [](std::size_t, std::size_t, const char*) {}));
+    }
+
+    TEST(verifyArbiterStageDrainsInSerialOrderAcrossTheWrap)
+    {
+        CountingErrorReportingPolicy16 errorPolicy;
+        arbiter::ArbiterStage<SerialStageTraits, int> stage(errorPolicy, 8);
+
+        // line 0 is past the wrap, line 1 still queues the sequence numbers before it.
+        CHECK(stage.push(0, 0, 0));
+        CHECK(stage.push(0, 1, 0));
+        CHECK(stage.push(1, 65533, 1));
+        CHECK(stage.push(1, 65534, 1));
+        CHECK(stage.push(1, 65535, 1));
+
+        std::vector<std::uint16_t> sequences;
+        CHECK_EQUAL(5U, stage.drain(
+            [&](const std::size_t, const std::uint16_t sequence, const int) { sequences.push_back(sequence); },
+            [](const std::size_t, const std::uint16_t, const int) {}));
+
+        REQUIRE CHECK_EQUAL(5U, sequences.size());
+        CHECK_EQUAL(65533, sequences[0]);
+        CHECK_EQUAL(65534, sequences[1]);
+        CHECK_EQUAL(65535, sequences[2]);
+        CHECK_EQUAL(0, sequences[3]);
+        CHECK_EQUAL(1, sequences[4]);
+
+        CHECK_EQUAL(0U, errorPolicy.gaps);
+        CHECK_EQUAL(0U, errorPolicy.gapFills);
+    }
+
+    TEST(verifyArbiterStageDrainsAtMostMaxMessages)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        Stage stage(errorPolicy, 8);
+
+        CHECK(stage.push(0, 0, nullptr));
+        CHECK(stage.push(0, 1, nullptr));
+        CHECK(stage.push(1, 0, nullptr));
+
+        std::size_t accepted = 0;
+        auto accept = [&](std::size_t, std::size_t, const char*) { ++accepted; };
+        auto reject = [](std::size_t, std::size_t, const char*) {};
+
+        CHECK_EQUAL(2U, stage.drain(accept, reject, 2));
+        CHECK_EQUAL(1U, stage.drain(accept, reject, 2));
+        CHECK_EQUAL(2U, accepted);
+    }
+
+    TEST(verifyArbiterStageAcceptsEverySequenceOnceFromLineThreads)
+    {
+        constexpr std::size_t Sequences = 50000;
+
+        CountingErrorReportingPolicy errorPolicy;
+        arbiter::ArbiterStage<StageTraits, std::size_t> stage(errorPolicy, 256);
+
+        std::atomic<std::size_t> running(StageTraits::NumberOfLines());
+        std::vector<std::thread> lines;
+
+        for(std::size_t line = 0; line < StageTraits::NumberOfLines(); ++line)
+        {
+            lines.emplace_back([&, line]
+            {
+                for(std::size_t sequence = 0; sequence < Sequences; ++sequence)
+                {
+                    while(!stage.push(line, sequence, sequence))
+                    {
+                    }
+                }
+
+                --running;
+            });
+        }
+
+        std::vector<std::size_t> accepts(Sequences, 0);
+        std::size_t wrongHandles = 0;
+
+        auto accept = [&](std::size_t, const std::size_t sequence, const std::size_t handle) { ++accepts[sequence]; wrongHandles += (handle == sequence) ? 0 : 1; };
+        auto reject = [](std::size_t, std::size_t, std::size_t) {};
+
+        while(running.load() != 0)
+        {
+            stage.drain(accept, reject);
+        }
+
+        stage.drain(accept, reject);
+
+        for(auto& line : lines)
+        {
+            line.join();
+        }
+
+        std::size_t wrong = 0;
+        for(auto count : accepts)
+        {
+            wrong += (count == 1) ? 0 : 1;
+        }
+
+        CHECK_EQUAL(0U, wrong);
+        CHECK_EQUAL(0U, wrongHandles);
+    }
+}
@@ -0,0 +1,258 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/ConcurrentSequenceArbiter.hpp>
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // called from every line's thread.
+    class CountingErrorReportingPolicy : public arbiter::details::NullErrorReportingPolicy<std::uint64_t>
+    {
+    public:
+        void FirstSequenceNumberOutOfSequence(const std::size_t, const std::uint64_t) { ++outOfSequence; }
+        void DuplicateOnLine(const std::size_t, const std::uint64_t) { ++duplicates; }
+        void Gap(const std::uint64_t, const std::uint64_t length) { gapMessages += length; }
+        void GapFill(const std::uint64_t, const std::uint64_t length) { gapFills += length; }
+        void UnrecoverableGap(const std::uint64_t, const std::uint64_t length = 1) { unrecoverableGaps += length; }
+
+        std::atomic<std::size_t> outOfSequence{0};
+        std::atomic<std::size_t> duplicates{0};
+        std::atomic<std::uint64_t> gapMessages{0};
+        std::atomic<std::uint64_t> gapFills{0};
+        std::atomic<std::uint64_t> unrecoverableGaps{0};
+    };
+
+    struct ConcurrentTraits
+    {
+        static constexpr std::uint64_t FirstExpectedSequenceNumber() { return 1; }
+        static constexpr std::uint64_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 8; }
+
+        using SequenceType = std::uint64_t;
+        using ErrorReportingPolicy = CountingErrorReportingPolicy;
+    };
+
+    struct StressTraits : public ConcurrentTraits
+    {
+        static constexpr std::size_t NumberOfLines() { return 4; }
+        static constexpr std::size_t HistoryDepth() { return 1 << 12; }
+    };
+
+    TEST(verifyConcurrentSequenceArbiterArbitratesLikeTheSequentialArbiter)
+    {
+        struct Message { std::size_t line; std::uint64_t sequence; };
+
+        // gaps, fills, duplicates and a forward jump past LargestRecoverableGap(), within the history.
+        const std::vector<Message> messages = {
+            {0, 0}, {0, 1}, {1, 1}, {1, 1}, {1, 4}, {0, 2}, {1, 2}, {0, 3},
+            {0, 12}, {1, 5}, {1, 6}, {1, 9}, {0, 9}, {0, 10}, {1, 13}, {0, 13}, {0, 14}
+        };
+
+        CountingErrorReportingPolicy concurrentPolicy;
+        arbiter::ConcurrentSequenceArbiter<ConcurrentTraits> concurrent(concurrentPolicy);
+
+        CountingErrorReportingPolicy sequentialPolicy;
+        arbiter::SequenceArbiter<ConcurrentTraits> sequential(sequentialPolicy);
+
+        for(const auto& message : messages)
+        {
+            CHECK_EQUAL(sequential.validate(message.line, message.sequence), concurrent.validate(message.line, message.sequence));
+        }
+
+        CHECK_EQUAL(1U, concurrentPolicy.outOfSequence.load());
+        CHECK_EQUAL(1U, concurrentPolicy.duplicates.load());
+        CHECK_EQUAL(7U, concurrentPolicy.gapMessages.load());
+        CHECK_EQUAL(4U, concurrentPolicy.gapFills.load());
+        CHECK_EQUAL(2U, concurrentPolicy.unrecoverableGaps.load());     // 5 and 6, 12 is 7 past head
+
+        CHECK_EQUAL(sequentialPolicy.outOfSequence.load(), concurrentPolicy.outOfSequence.load());
+        CHECK_EQUAL(sequentialPolicy.duplicates.load(), concurrentPolicy.duplicates.load());
+        CHECK_EQUAL(sequentialPolicy.gapMessages.load(), concurrentPolicy.gapMessages.load());
+        CHECK_EQUAL(sequentialPolicy.gapFills.load(), concurrentPolicy.gapFills.load());
+        CHECK_EQUAL(sequentialPolicy.unrecoverableGaps.load(), concurrentPolicy.unrecoverableGaps.load());
+    }
+
+    TEST(verifyConcurrentSequenceArbiterLosesSequencesAHistoryDepthBehind)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        arbiter::ConcurrentSequenceArbiter<ConcurrentTraits> arbiter(errorPolicy);
+
+        CHECK(arbiter.validate(0, 1));
+        CHECK(arbiter.validate(1, 4));      // gap of 2
+        CHECK(arbiter.validate(0, 2));      // filled
+
+        // the slots are indexed by sequence number, 3's is reused by 11 whatever the line
+        // positions (SequenceArbiter keeps slots in arrival order and would still accept 3).
+        CHECK(arbiter.validate(0, 11));     // 5 is unrecoverable, 6 to 10 are a gap
+        CHECK_EQUAL(2U, errorPolicy.unrecoverableGaps.load());     // 5, and 3 leaving the history unfilled
+        CHECK_EQUAL(7U, errorPolicy.gapMessages.load());
+
+        CHECK(!arbiter.validate(1, 3));     // too late
+        CHECK(!arbiter.validate(1, 5));     // unrecoverable, discarded without a report
+        CHECK(arbiter.validate(1, 6));
+
+        CHECK(arbiter.validate(0, 12));
+        CHECK(arbiter.validate(0, 13));     // reuses 5's slot without reporting it again
+        CHECK_EQUAL(2U, errorPolicy.unrecoverableGaps.load());
+
+        CHECK(arbiter.validate(0, 40));     // 14 to 34 are unrecoverable, 35 to 39 a gap
+        CHECK_EQUAL(2U + 21U + 4U, errorPolicy.unrecoverableGaps.load());    // and 7 to 10 left the history unfilled
+        CHECK_EQUAL(7U + 5U, errorPolicy.gapMessages.load());
+
+        CHECK(!arbiter.validate(1, 34));
+        CHECK(arbiter.validate(1, 35));
+
+        arbiter.reset();
+        CHECK(arbiter.validate(1, 1));
+    }
+
+    TEST(verifyConcurrentSequenceArbiterAcceptsEachSequenceExactlyOnceAcrossThreads)
+    {
+        constexpr std::size_t Lines = StressTraits::NumberOfLines();
+        constexpr std::uint64_t Sequences = 200000;
+
+        CountingErrorReportingPolicy errorPolicy;
+        arbiter::ConcurrentSequenceArbiter<StressTraits> arbiter(errorPolicy);
+
+        std::unique_ptr<std::atomic<std::uint32_t>[]> accepts(new std::atomic<std::uint32_t>[Sequences + 1]);
+        for(std::uint64_t i = 0; i <= Sequences; ++i)
+        {
+            accepts[i].store(0, std::memory_order_relaxed);
+        }
+
+        std::atomic<std::size_t> rejectedRepeats(0);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> lines;
+
+        for(std::size_t line = 0; line < Lines; ++line)
+        {
+            lines.emplace_back([&, line]
+            {
+                while(!go.load(std::memory_order_acquire))
+                {
+                }
+
+                // every line delivers every sequence number, some twice.
+                for(std::uint64_t sequence = 1; sequence <= Sequences; ++sequence)
+                {
+                    if(arbiter.validate(line, sequence))
+                    {
+                        accepts[sequence].fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    if(((sequence + line) % 1000) == 0)
+                    {
+                        rejectedRepeats += arbiter.validate(line, sequence) ? 0 : 1;
+                    }
+                }
+            });
+        }
+
+        go.store(true, std::memory_order_release);
+        for(auto& line : lines)
+        {
+            line.join();
+        }
+
+        std::size_t wrong = 0;
+        for(std::uint64_t sequence = 1; sequence <= Sequences; ++sequence)
+        {
+            wrong += accepts[sequence].load(std::memory_order_relaxed) == 1 ? 0 : 1;
+        }
+
+        CHECK_EQUAL(0U, wrong);
+        CHECK_EQUAL(Lines * Sequences / 1000, rejectedRepeats.load());
+
+        // a line lapped by the others finds its repeat gone from the history rather than a duplicate.
+        CHECK(errorPolicy.duplicates.load() <= Lines * Sequences / 1000);
+        CHECK_EQUAL(0U, errorPolicy.unrecoverableGaps.load());
+    }
+
+    TEST(verifyConcurrentSequenceArbiterAcceptsEachSequenceAtMostOnceOnLossyLines)
+    {
+        constexpr std::size_t Lines = StressTraits::NumberOfLines();
+        constexpr std::uint64_t Sequences = 200000;
+
+        CountingErrorReportingPolicy errorPolicy;
+        arbiter::ConcurrentSequenceArbiter<StressTraits> arbiter(errorPolicy);
+
+        std::unique_ptr<std::atomic<std::uint32_t>[]> accepts(new std::atomic<std::uint32_t>[Sequences + 1]);
+        for(std::uint64_t i = 0; i <= Sequences; ++i)
+        {
+            accepts[i].store(0, std::memory_order_relaxed);
+        }
+
+        std::atomic<bool> go(false);
+        std::vector<std::thread> lines;
+
+        for(std::size_t line = 0; line < Lines; ++line)
+        {
+            lines.emplace_back([&, line]
+            {
+                std::uint64_t state = 71 + line;
+                auto random = [&state](const std::uint64_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+                auto validate = [&](const std::uint64_t sequence)
+                {
+                    if(arbiter.validate(line, sequence))
+                    {
+                        accepts[sequence].fetch_add(1, std::memory_order_relaxed);
+                    }
+                };
+
+                while(!go.load(std::memory_order_acquire))
+                {
+                }
+
+                // each line drops messages, jumps past LargestRecoverableGap() and repeats stale ones.
+                for(std::uint64_t sequence = 1; sequence <= Sequences; ++sequence)
+                {
+                    switch(random(64))
+                    {
+                        case 0: sequence += 1 + random(3); break;
+                        case 1: sequence += StressTraits::LargestRecoverableGap() + 1 + random(32); break;
+                        case 2: case 3: validate(sequence - random(sequence < 64 ? sequence : 64)); break;
+                        default: break;
+                    }
+
+                    if(sequence <= Sequences)
+                    {
+                        validate(sequence);
+                    }
+                }
+            });
+        }
+
+        go.store(true, std::memory_order_release);
+        for(auto& line : lines)
+        {
+            line.join();
+        }
+
+        std::size_t accepted = 0;
+        std::size_t twice = 0;
+
+        for(std::uint64_t sequence = 1; sequence <= Sequences; ++sequence)
+        {
+            const auto count = accepts[sequence].load(std::memory_order_relaxed);
+            accepted += count != 0 ? 1 : 0;
+            twice += count > 1 ? 1 : 0;
+        }
+
+        CHECK_EQUAL(0U, twice);
+        CHECK(accepted > Sequences / 2);
+
+        // the lines' losses and jumps were reported.
+        CHECK(errorPolicy.gapMessages.load() > 0);
+        CHECK(errorPolicy.unrecoverableGaps.load() > 0);
+        CHECK(errorPolicy.duplicates.load() > 0);
+    }
+}
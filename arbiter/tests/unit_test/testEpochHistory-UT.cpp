@@ -0,0 +1,57 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/details/EpochHistory.hpp>
+#include <arbiter/details/SequenceInfo.hpp>
+
+#include <cstddef>
+
+namespace {
+
+    using SeqInfo = arbiter::details::SequenceInfo<std::size_t, 2>;
+
+    TEST(verifyEpochHistoryStartsWithDefaultSlots)
+    {
+        arbiter::details::EpochHistory<SeqInfo, 4> history;
+        CHECK_EQUAL(4U, history.size());
+
+        for(std::size_t position = 0; position < history.size(); ++position)
+        {
+            CHECK_EQUAL(0U, history[position].sequence());
+            CHECK(history[position].complete());
+        }
+    }
+
+    TEST(verifyEpochHistoryKeepsWritesWithinAGeneration)
+    {
+        arbiter::details::EpochHistory<SeqInfo, 4> history;
+
+        history[1] = SeqInfo(0, 5);
+        history[2] = SeqInfo(6);
+
+        CHECK_EQUAL(5U, history[1].sequence());
+        CHECK(history[1].has(0));
+        CHECK(!history[1].has(1));
+
+        CHECK_EQUAL(6U, history[2].sequence());
+        CHECK(history[2].empty());
+    }
+
+    TEST(verifyEpochHistoryResetMakesSlotsStale)
+    {
+        arbiter::details::EpochHistory<SeqInfo, 4> history;
+
+        history[1] = SeqInfo(0, 5);
+        history[2] = SeqInfo(6);
+
+        history.reset();
+
+        CHECK_EQUAL(0U, history[1].sequence());
+        CHECK(history[1].complete());
+
+        CHECK_EQUAL(0U, history[2].sequence());
+        CHECK(history[2].complete());
+
+        history[2] = SeqInfo(1, 7);
+        CHECK_EQUAL(7U, history[2].sequence());
+        CHECK(history[2].has(1));
+    }
+}
@@ -0,0 +1,105 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/details/ArbiterCacheAdvancerContext.hpp>
+#include <arbiter/details/ErrorReportingPolicyTraits.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+#include <arbiter/details/SequenceInfo.hpp>
+
+#include <cstddef>
+
+namespace {
+
+    using NullPolicy = arbiter::details::NullErrorReportingPolicy<std::size_t>;
+    using LineSet = arbiter::details::SequenceInfo<std::size_t, 2>::LineSet;
+
+    template<class ErrorReportingPolicy>
+    using PolicyTraits = arbiter::details::ErrorReportingPolicyTraits<ErrorReportingPolicy, LineSet, std::size_t>;
+
+    class DuplicatesOnlyPolicy : public NullPolicy
+    {
+    public:
+        void DuplicateOnLine(const std::size_t, const std::size_t) {}
+    };
+
+    class BulkLineGapsPolicy : public NullPolicy
+    {
+    public:
+        template<class Lines>
+        void UnrecoverableLineGaps(const Lines&, const std::size_t) {}
+    };
+
+    class LineGapPolicy : public NullPolicy
+    {
+    public:
+        void UnrecoverableLineGap(const std::size_t, const std::size_t) {}
+    };
+
+    // implements every callback without deriving from NullErrorReportingPolicy.
+    class StandalonePolicy
+    {
+    public:
+        void FirstSequenceNumberOutOfSequence(const std::size_t, const std::size_t) {}
+        void DuplicateOnLine(const std::size_t, const std::size_t) {}
+        void Gap(const std::size_t, const std::size_t) {}
+        void GapFill(const std::size_t, const std::size_t) {}
+        void LinePositionOverrun(const std::size_t, const std::size_t) {}
+        void UnrecoverableGap(const std::size_t, const std::size_t = 1) {}
+        void UnrecoverableLineGap(const std::size_t, const std::size_t) {}
+    };
+
+    TEST(verifyErrorReportingPolicyTraitsElidesNullCallbacks)
+    {
+        static_assert(!PolicyTraits<NullPolicy>::ReportsFirstSequenceNumberOutOfSequence(), "");
+        static_assert(!PolicyTraits<NullPolicy>::ReportsDuplicateOnLine(), "");
+        static_assert(!PolicyTraits<NullPolicy>::ReportsGap(), "");
+        static_assert(!PolicyTraits<NullPolicy>::ReportsGapFill(), "");
+        static_assert(!PolicyTraits<NullPolicy>::ReportsLinePositionOverrun(), "");
+        static_assert(!PolicyTraits<NullPolicy>::ReportsUnrecoverableGap(), "");
+        static_assert(!PolicyTraits<NullPolicy>::ReportsUnrecoverableLineGaps(), "");
+    }
+
+    TEST(verifyErrorReportingPolicyTraitsDetectsRedefinedCallbacks)
+    {
+        static_assert(PolicyTraits<DuplicatesOnlyPolicy>::ReportsDuplicateOnLine(), "");
+        static_assert(!PolicyTraits<DuplicatesOnlyPolicy>::ReportsGap(), "");
+        static_assert(!PolicyTraits<DuplicatesOnlyPolicy>::ReportsUnrecoverableLineGaps(), "");
+
+        static_assert(PolicyTraits<BulkLineGapsPolicy>::ReportsUnrecoverableLineGaps(), "");
+        static_assert(!PolicyTraits<BulkLineGapsPolicy>::ReportsDuplicateOnLine(), "");
+
+        static_assert(PolicyTraits<LineGapPolicy>::ReportsUnrecoverableLineGaps(), "");
+        static_assert(!PolicyTraits<LineGapPolicy>::ReportsUnrecoverableGap(), "");
+    }
+
+    TEST(verifyErrorReportingPolicyTraitsReportsEveryCallbackOfStandalonePolicy)
+    {
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsFirstSequenceNumberOutOfSequence(), "");
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsDuplicateOnLine(), "");
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsGap(), "");
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsGapFill(), "");
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsLinePositionOverrun(), "");
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsUnrecoverableGap(), "");
+        static_assert(PolicyTraits<StandalonePolicy>::ReportsUnrecoverableLineGaps(), "");
+    }
+
+    template<bool ByValue>
+    struct HolderTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+        static constexpr bool ErrorReportingPolicyByValue() { return ByValue; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = NullPolicy;
+    };
+
+    TEST(verifyStatelessPolicyHeldByValueTakesNoSpace)
+    {
+        using ByValue = arbiter::details::ArbiterCacheAdvancerContext<HolderTraits<true>>;
+        using ByReference = arbiter::details::ArbiterCacheAdvancerContext<HolderTraits<false>>;
+
+        CHECK_EQUAL(sizeof(void*), sizeof(ByValue));
+        CHECK_EQUAL(2 * sizeof(void*), sizeof(ByReference));
+    }
+}
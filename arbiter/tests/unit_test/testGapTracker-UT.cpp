@@ -0,0 +1,377 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/GapTracker.hpp>
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using Tracker = arbiter::GapTracker<std::size_t>;
+    using Requests = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    struct TrackerTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = Tracker;
+    };
+
+    // the missing sequence numbers, one at a time.
+    struct ReferencePolicy : public arbiter::details::NullErrorReportingPolicy<std::size_t>
+    {
+        void Gap(const std::size_t start, const std::size_t length) { for(std::size_t i = 0; i < length; ++i) expected.insert(start + i); }
+        void GapFill(const std::size_t start, const std::size_t length) { for(std::size_t i = 0; i < length; ++i) expected.erase(start + i); }
+        void UnrecoverableGap(const std::size_t start, const std::size_t length = 1) { for(std::size_t i = 0; i < length; ++i) expected.erase(start + i); }
+
+        std::set<std::size_t> expected;
+    };
+
+    using CheckedTracker = arbiter::GapTracker<std::size_t, ReferencePolicy>;
+
+    struct CheckedTraits : public TrackerTraits
+    {
+        static constexpr std::size_t LargestRecoverableGap() { return 16; }
+        static constexpr std::size_t NumberOfLines() { return 3; }
+        static constexpr std::size_t HistoryDepth() { return 64; }
+
+        using ErrorReportingPolicy = CheckedTracker;
+    };
+
+    Requests poll(Tracker& tracker, const std::uint64_t now)
+    {
+        Requests requests;
+        tracker.requestRetransmissions(now, [&requests](const std::size_t first, const std::size_t length) { requests.emplace_back(first, length); });
+
+        return requests;
+    }
+
+    template<class Range>
+    std::set<std::size_t> expand(const std::vector<Range>& ranges)
+    {
+        std::set<std::size_t> sequences;
+        for(const auto& range : ranges)
+        {
+            for(std::size_t i = 0; i < range.length; ++i)
+            {
+                sequences.insert(range.first + i);
+            }
+        }
+
+        return sequences;
+    }
+
+    TEST(verifyGapTrackerFollowsGapsAndGapFills)
+    {
+        const arbiter::RetransmissionConfig config(0, 100);
+        Tracker tracker(Tracker::capacity(TrackerTraits::HistoryDepth(), config), config);
+        arbiter::SequenceArbiter<TrackerTraits> arbiter(tracker);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 5));      // gap of 4
+
+        auto gaps = tracker.outstandingGaps();
+        CHECK_EQUAL(1U, gaps.size());
+        CHECK_EQUAL(1U, gaps[0].first);
+        CHECK_EQUAL(4U, gaps[0].length);
+        CHECK_EQUAL(4U, tracker.missing());
+
+        CHECK(arbiter.validate(1, 2));      // fills the middle of the gap
+
+        gaps = tracker.outstandingGaps();
+        CHECK_EQUAL(2U, gaps.size());
+        CHECK_EQUAL(1U, gaps[0].first);
+        CHECK_EQUAL(1U, gaps[0].length);
+        CHECK_EQUAL(3U, gaps[1].first);
+        CHECK_EQUAL(2U, gaps[1].length);
+        CHECK_EQUAL(3U, tracker.missing());
+
+        CHECK(arbiter.validate(1, 3));
+        CHECK(arbiter.validate(1, 4));
+        CHECK(arbiter.validate(1, 1));      // line 1 behind line 0 since the fill, fills 1
+
+        CHECK_EQUAL(0U, tracker.gaps());
+        CHECK_EQUAL(0U, tracker.missing());
+    }
+
+    TEST(verifyGapTrackerDropsGapsWhichLeaveTheHistory)
+    {
+        const arbiter::RetransmissionConfig config(0, 100);
+        Tracker tracker(Tracker::capacity(TrackerTraits::HistoryDepth(), config), config);
+        arbiter::SequenceArbiter<TrackerTraits> arbiter(tracker);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 3));      // 1, 2 missing
+        CHECK_EQUAL(2U, tracker.missing());
+
+        // head overwrites 1 and 2 one slot at a time.
+        for(std::size_t sequence = 4; sequence <= 11; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+
+        CHECK_EQUAL(1U, tracker.missing());
+        CHECK(arbiter.validate(0, 12));
+        CHECK_EQUAL(0U, tracker.gaps());
+
+        // a gap of 5 then a jump over the history, the gap slots it overwrites are unrecoverable.
+        CHECK(arbiter.validate(0, 18));
+        CHECK_EQUAL(5U, tracker.missing());
+
+        CHECK(arbiter.validate(0, 24));     // 5 more missing, 13 and 14 leave the history
+
+        auto gaps = tracker.outstandingGaps();
+        CHECK_EQUAL(2U, gaps.size());
+        CHECK_EQUAL(15U, gaps[0].first);
+        CHECK_EQUAL(3U, gaps[0].length);
+        CHECK_EQUAL(19U, gaps[1].first);
+        CHECK_EQUAL(5U, gaps[1].length);
+
+        CHECK(arbiter.validate(0, 40));     // beyond the largest recoverable gap, 21 to 24 keep their slots
+        gaps = tracker.outstandingGaps();
+
+        CHECK_EQUAL(2U, gaps.size());
+        CHECK_EQUAL(21U, gaps[0].first);
+        CHECK_EQUAL(3U, gaps[0].length);
+        CHECK_EQUAL(35U, gaps[1].first);
+        CHECK_EQUAL(5U, gaps[1].length);
+
+        // until head overwrites them.
+        CHECK(arbiter.validate(0, 41));
+        CHECK(arbiter.validate(0, 42));
+        CHECK(arbiter.validate(0, 43));
+
+        gaps = tracker.outstandingGaps();
+        CHECK_EQUAL(1U, gaps.size());
+        CHECK_EQUAL(35U, gaps[0].first);
+        CHECK_EQUAL(5U, gaps[0].length);
+    }
+
+    TEST(verifyGapTrackerClearsWhenTheArbiterIsReset)
+    {
+        const arbiter::RetransmissionConfig config(0, 100);
+        Tracker tracker(Tracker::capacity(TrackerTraits::HistoryDepth(), config), config);
+        arbiter::SequenceArbiter<TrackerTraits> arbiter(tracker);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 6));
+        CHECK_EQUAL(5U, tracker.missing());
+
+        arbiter.reset();
+        tracker.clear();
+        CHECK_EQUAL(0U, tracker.gaps());
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 2));
+        CHECK_EQUAL(1U, tracker.missing());
+
+        // a gap behind those open starts over, as if clear() was called.
+        tracker.Gap(0, 1);
+        CHECK_EQUAL(1U, tracker.gaps());
+        CHECK_EQUAL(0U, tracker.outstandingGaps()[0].first);
+    }
+
+    TEST(verifyGapTrackerRequestsOnceTheDelayHasPassed)
+    {
+        Tracker tracker(1000, arbiter::RetransmissionConfig(10, 50));
+
+        tracker.Gap(100, 5);
+        CHECK(poll(tracker, 1000).empty());     // opened at 1000
+        CHECK(poll(tracker, 1009).empty());
+
+        tracker.Gap(200, 5);                    // opened at 1010
+        CHECK(poll(tracker, 1010) == (Requests{{100, 5}}));
+        CHECK(poll(tracker, 1019).empty());
+        CHECK(poll(tracker, 1020) == (Requests{{200, 5}}));
+
+        // retried while open.
+        CHECK(poll(tracker, 1059).empty());
+        CHECK(poll(tracker, 1060) == (Requests{{100, 5}}));
+
+        tracker.GapFill(200, 5);
+        CHECK(poll(tracker, 1070).empty());
+
+        tracker.GapFill(101, 1);                // the rest of the gap keeps its schedule
+        CHECK(poll(tracker, 1110) == (Requests{{100, 1}, {102, 3}}));
+    }
+
+    TEST(verifyGapTrackerMergesCloseGaps)
+    {
+        Tracker tracker(1000, arbiter::RetransmissionConfig(0, 50, 3));
+
+        tracker.Gap(10, 2);         // 10, 11
+        tracker.Gap(15, 1);         // 3 delivered between, merged
+        tracker.Gap(20, 2);         // 4 between, not merged
+        tracker.Gap(23, 1);
+
+        CHECK(poll(tracker, 0) == (Requests{{10, 6}, {20, 4}}));
+        CHECK_EQUAL(4U, tracker.gaps());
+        CHECK_EQUAL(6U, tracker.missing());
+
+        tracker.Gap(26, 1);
+        CHECK(poll(tracker, 30) == (Requests{{26, 1}}));
+
+        // a gap not yet due for a retry isn't merged.
+        tracker.GapFill(10, 2);
+        CHECK(poll(tracker, 50) == (Requests{{15, 1}, {20, 4}}));
+        CHECK(poll(tracker, 100) == (Requests{{15, 1}, {20, 7}}));
+    }
+
+    TEST(verifyGapTrackerSplitsLongGapsAndLimitsRequests)
+    {
+        Tracker tracker(100000, arbiter::RetransmissionConfig(0, 50, 10, 1000, 3));
+
+        tracker.Gap(1, 2500);
+        tracker.Gap(3000, 10);
+        tracker.Gap(4000, 10);
+
+        CHECK(poll(tracker, 0) == (Requests{{1, 1000}, {1001, 1000}, {2001, 500}}));
+        CHECK(poll(tracker, 1) == (Requests{{3000, 10}, {4000, 10}}));
+        CHECK_EQUAL(2520U, tracker.missing());
+
+        // a merge stops at the longest range.
+        Tracker merging(100000, arbiter::RetransmissionConfig(0, 50, 10, 20));
+        merging.Gap(0, 8);
+        merging.Gap(10, 8);
+        merging.Gap(20, 8);
+
+        CHECK(poll(merging, 0) == (Requests{{0, 18}, {20, 8}}));
+    }
+
+    TEST(verifyGapTrackerOrdersGapsAcrossTheSequenceWrap)
+    {
+        arbiter::GapTracker<std::uint16_t> tracker(1000, arbiter::RetransmissionConfig(0, 50, 2));
+
+        tracker.Gap(65530, 3);
+        tracker.Gap(65535, 4);      // 65535, 0, 1, 2
+
+        std::vector<std::pair<std::uint16_t, std::size_t>> requests;
+        tracker.requestRetransmissions(0, [&requests](const std::uint16_t first, const std::size_t length) { requests.emplace_back(first, length); });
+
+        CHECK_EQUAL(1U, requests.size());
+        CHECK_EQUAL(65530U, requests[0].first);
+        CHECK_EQUAL(9U, requests[0].second);
+
+        tracker.GapFill(0, 1);
+        auto gaps = tracker.outstandingGaps();
+
+        CHECK_EQUAL(3U, gaps.size());
+        CHECK_EQUAL(65535U, gaps[1].first);
+        CHECK_EQUAL(1U, gaps[1].length);
+        CHECK_EQUAL(1U, gaps[2].first);
+        CHECK_EQUAL(2U, gaps[2].length);
+    }
+
+    // a history of 8 slots growing up to 64 to keep slots missing a line for 100 ticks.
+    struct GrowingTraits : public TrackerTraits
+    {
+        static constexpr std::size_t LargestRecoverableGap() { return 32; }
+        static constexpr std::size_t HistoryDepth() { return 64; }
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::Dynamic; }
+        static constexpr bool ArrivalTimestamps() { return true; }
+
+        static arbiter::HistoryConfig Config()
+        {
+            arbiter::HistoryConfig config(2, 8);
+            config.maxHistoryDepth = 64;
+            config.minimumAge = 100;
+
+            return config;
+        }
+    };
+
+    TEST(verifyGapTrackerKeepsGapsAGrownHistoryKeeps)
+    {
+        Tracker tracker(8, arbiter::RetransmissionConfig(0, 100));
+        arbiter::SequenceArbiter<GrowingTraits> arbiter(tracker, GrowingTraits::Config());
+
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(arbiter.validate(0, 2, 0));       // 1 missing
+        CHECK(arbiter.validate(0, 20, 10));     // 3 to 19 missing, the history grows to keep 1
+
+        CHECK(arbiter.historyDepth() > 8);
+
+        auto gaps = tracker.outstandingGaps();
+        CHECK_EQUAL(2U, gaps.size());
+        CHECK_EQUAL(1U, gaps[0].first);
+        CHECK_EQUAL(1U, gaps[0].length);
+        CHECK_EQUAL(3U, gaps[1].first);
+        CHECK_EQUAL(17U, gaps[1].length);
+
+        for(std::size_t sequence = 0; sequence <= 20; ++sequence)
+        {
+            arbiter.validate(1, sequence, 50);
+        }
+
+        CHECK_EQUAL(0U, tracker.gaps());
+        CHECK_EQUAL(0U, tracker.missing());
+    }
+
+    TEST(verifyGapTrackerMatchesEveryGapCallback)
+    {
+        // requests split every gap into ranges of 2.
+        const arbiter::RetransmissionConfig config(0, 100, 0, 2, 1000);
+        const std::size_t capacity = CheckedTracker::capacity(CheckedTraits::HistoryDepth(), config);
+
+        CheckedTracker tracker(capacity, config);
+        arbiter::SequenceArbiter<CheckedTraits> arbiter(tracker);
+
+        std::size_t state = 21;
+        auto random = [&state](const std::size_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+        // gaps stay recoverable, every sequence number missing is reported by Gap().
+        std::vector<std::size_t> next(CheckedTraits::NumberOfLines(), 0);
+
+        for(std::size_t round = 0; round < 5000; ++round)
+        {
+            const std::size_t line = random(next.size());
+            switch(random(16))
+            {
+                case 0: next[line] += 1 + random(6); break;
+                case 1: next[line] += 1 + random(CheckedTraits::LargestRecoverableGap()); break;
+                case 2: next[line] -= next[line] > 3 ? random(4) : 0; break;
+                default: break;
+            }
+
+            arbiter.validate(line, next[line]++);
+
+            // gaps head overwrites are reported as unrecoverable, the reference closes them too.
+            CHECK(expand(tracker.outstandingGaps()) == tracker.expected);
+            CHECK_EQUAL(tracker.expected.size(), tracker.missing());
+
+            tracker.requestRetransmissions(round, [](const std::size_t, const std::size_t) {});
+            CHECK(tracker.gaps() <= capacity);
+        }
+    }
+
+    TEST(verifyGapTrackerCapacityHoldsSplitGaps)
+    {
+        // every request a single sequence number.
+        const arbiter::RetransmissionConfig config(0, 100, 0, 1, 1000);
+        const std::size_t capacity = CheckedTracker::capacity(CheckedTraits::HistoryDepth(), config);
+
+        CheckedTracker tracker(capacity, config);
+        arbiter::SequenceArbiter<CheckedTraits> arbiter(tracker);
+
+        // three gaps of 16 in a history of 64, one range per sequence number once requested.
+        for(std::size_t sequence = 0; sequence < 54; sequence += 18)
+        {
+            CHECK(arbiter.validate(0, sequence));
+            CHECK(arbiter.validate(0, sequence + 17));
+        }
+
+        CHECK_EQUAL(48U, tracker.requestRetransmissions(0, [](const std::size_t, const std::size_t) {}));
+        CHECK_EQUAL(48U, tracker.gaps());
+
+        CHECK(tracker.gaps() > CheckedTraits::HistoryDepth() / 2 + 1);
+        CHECK(tracker.gaps() <= capacity);
+    }
+}
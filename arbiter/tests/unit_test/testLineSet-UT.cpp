@@ -1,6 +1,7 @@
 #include "./platform/UnitTestSupport.hpp"
 #include <arbiter/details/LineSet.hpp>
 #include <stdexcept>
+#include <vector>
 
 namespace {
 
@@ -93,4 +94,98 @@ namespace {
         set.fill();
         CHECK(set.complete());
     }
+
+    TEST(verifyCount)
+    {
+        arbiter::details::LineSet<3> set;
+        CHECK_EQUAL(0U, set.count());
+
+        set.insert(2);
+        CHECK_EQUAL(1U, set.count());
+
+        set.insert(0);
+        CHECK_EQUAL(2U, set.count());
+    }
+
+    TEST(verifyForEachAndForEachMissing)
+    {
+        arbiter::details::LineSet<5> set;
+        set.insert(1);
+        set.insert(4);
+
+        std::vector<std::size_t> lines;
+        set.forEach([&lines](const std::size_t lineId) { lines.push_back(lineId); });
+
+        /*REQUIRE*/ CHECK_EQUAL(2U, lines.size());
+        CHECK_EQUAL(1U, lines[0]);
+        CHECK_EQUAL(4U, lines[1]);
+
+        lines.clear();
+        set.forEachMissing([&lines](const std::size_t lineId) { lines.push_back(lineId); });
+
+        /*REQUIRE*/ CHECK_EQUAL(3U, lines.size());
+        CHECK_EQUAL(0U, lines[0]);
+        CHECK_EQUAL(2U, lines[1]);
+        CHECK_EQUAL(3U, lines[2]);
+    }
+
+    TEST(verifyForEachMissingAcrossWords)
+    {
+        arbiter::details::LineSet<130> set;
+        set.fill();
+
+        CHECK_EQUAL(130U, set.count());
+
+        auto missingLines = set.missingLines();
+        CHECK(missingLines.empty());
+
+        arbiter::details::LineSet<130> partial;
+        partial.insert(0);
+        partial.insert(63);
+        partial.insert(64);
+        partial.insert(129);
+
+        std::vector<std::size_t> lines;
+        partial.forEach([&lines](const std::size_t lineId) { lines.push_back(lineId); });
+
+        /*REQUIRE*/ CHECK_EQUAL(4U, lines.size());
+        CHECK_EQUAL(0U, lines[0]);
+        CHECK_EQUAL(63U, lines[1]);
+        CHECK_EQUAL(64U, lines[2]);
+        CHECK_EQUAL(129U, lines[3]);
+
+        std::size_t missing = 0;
+        partial.forEachMissing([&missing](const std::size_t lineId) { CHECK(lineId < 130U); ++missing; });
+        CHECK_EQUAL(126U, missing);
+        CHECK_EQUAL(126U, partial.missingLines().count());
+    }
+
+    TEST(verifyCompleteAndEmptyAcrossWords)
+    {
+        arbiter::details::LineSet<65> set;
+        CHECK(set.empty());
+        CHECK(!set.complete());
+
+        for(std::size_t lineId = 0; lineId < 64; ++lineId)
+        {
+            set.insert(lineId);
+        }
+
+        CHECK(!set.empty());
+        CHECK(!set.complete());
+        CHECK_EQUAL(1U, set.missingLines().count());
+
+        CHECK(set.insert(64));
+        CHECK(!set.insert(64));
+        CHECK(set.complete());
+        CHECK_EQUAL(65U, set.count());
+
+        CHECK_THROW(set.insert(65), std::out_of_range);
+
+        // bits past the last line are dropped, they don't make a set complete.
+        arbiter::details::LineSet<3> lines(~0ULL);
+        CHECK(lines.complete());
+        CHECK_EQUAL(3U, lines.count());
+        CHECK_EQUAL(7U, lines.word(0));
+    }
 }
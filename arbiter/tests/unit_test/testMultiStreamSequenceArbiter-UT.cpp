@@ -0,0 +1,185 @@
+#include "./platform/UnitTestSupport.hpp"
+
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/HistoryPool.hpp>
+#include <arbiter/MultiStreamSequenceArbiter.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+    class CountingErrorReportingPolicy : public arbiter::details::NullErrorReportingPolicy<std::size_t>
+    {
+    public:
+        void DuplicateOnLine(const std::size_t, const std::size_t) { ++duplicates; }
+
+        std::size_t duplicates = 0;
+    };
+
+    struct StreamTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = CountingErrorReportingPolicy;
+    };
+
+    struct DynamicStreamTraits : public StreamTraits
+    {
+        static constexpr std::size_t NumberOfLines() { return 4; }
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::Dynamic; }
+    };
+
+    using MultiStreamArbiter = arbiter::MultiStreamSequenceArbiter<StreamTraits>;
+
+    TEST(verifyMultiStreamSequenceArbiterKeepsStreamsIndependent)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        MultiStreamArbiter arbiter(errorPolicy, 4, 8);
+
+        arbiter.addStream(1);
+        arbiter.addStream(2);
+        CHECK_EQUAL(2U, arbiter.size());
+        CHECK_EQUAL(4U, arbiter.capacity());
+
+        CHECK(arbiter.validate(1, 0, 0));
+        CHECK(arbiter.validate(2, 0, 0));   // same sequence on another stream
+
+        CHECK(!arbiter.validate(1, 1, 0));
+        CHECK(arbiter.validate(1, 1, 1));
+        CHECK(!arbiter.validate(2, 0, 0));
+
+        CHECK_EQUAL(1U, errorPolicy.duplicates);
+    }
+
+    TEST(verifyMultiStreamSequenceArbiterFindsDenseAndSparseStreamIds)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        MultiStreamArbiter arbiter(errorPolicy, 64, 16);
+
+        // dense ids, then sparse ids which collide in a small table.
+        for(std::size_t streamId = 0; streamId < 16; ++streamId)
+        {
+            arbiter.addStream(streamId);
+        }
+
+        for(std::size_t i = 0; i < 48; ++i)
+        {
+            arbiter.addStream(1000 + i * 4096);
+        }
+
+        CHECK_EQUAL(64U, arbiter.size());
+
+        for(std::size_t streamId = 0; streamId < 16; ++streamId)
+        {
+            REQUIRE CHECK(arbiter.find(streamId) != nullptr);
+            CHECK(arbiter.validate(streamId, 0, streamId));
+        }
+
+        for(std::size_t i = 0; i < 48; ++i)
+        {
+            REQUIRE CHECK(arbiter.find(1000 + i * 4096) != nullptr);
+            CHECK(arbiter.validate(1000 + i * 4096, 1, i));
+        }
+
+        CHECK(arbiter.find(16) == nullptr);
+        CHECK(arbiter.find(1000 + 48 * 4096) == nullptr);
+    }
+
+    TEST(verifyMultiStreamSequenceArbiterSlotsAreCacheLineAligned)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        MultiStreamArbiter arbiter(errorPolicy, 3);
+
+        for(std::size_t streamId = 0; streamId < 3; ++streamId)
+        {
+            auto& stream = arbiter.addStream(streamId);
+            CHECK_EQUAL(0U, reinterpret_cast<std::uintptr_t>(&stream) % 64);
+            CHECK_EQUAL(&stream, &arbiter.stream(streamId));
+        }
+    }
+
+    TEST(verifyMultiStreamSequenceArbiterThrowsOnUnknownDuplicateAndFullStreams)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        MultiStreamArbiter arbiter(errorPolicy, 2, 4);
+
+        arbiter.addStream(3);
+        arbiter.addStream(100);
+
+        CHECK_THROW(arbiter.addStream(3), arbiter::DuplicateStream);
+        CHECK_THROW(arbiter.addStream(100), arbiter::DuplicateStream);
+        CHECK_THROW(arbiter.addStream(4), arbiter::StreamCapacityExceeded);
+
+        CHECK_THROW(arbiter.validate(1, 0, 0), arbiter::UnknownStream);
+        CHECK_THROW(arbiter.validate(101, 0, 0), arbiter::UnknownStream);
+    }
+
+    TEST(verifyMultiStreamSequenceArbiterResetsOneOrEveryStream)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        MultiStreamArbiter arbiter(errorPolicy, 2, 2);
+
+        arbiter.addStream(0);
+        arbiter.addStream(1);
+
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(arbiter.validate(1, 0, 0));
+
+        arbiter.reset(0);
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(!arbiter.validate(1, 0, 0));
+
+        arbiter.reset();
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(arbiter.validate(1, 0, 0));
+    }
+
+    TEST(verifyMultiStreamSequenceArbiterValidateBatch)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        MultiStreamArbiter arbiter(errorPolicy, 1);
+
+        arbiter.addStream(7);
+
+        const std::size_t sequences[] = {0, 1, 2, 2};
+        bool accept[4];
+
+        CHECK_EQUAL(3U, arbiter.validateBatch(7, 0, sequences, 4, accept));
+        CHECK(!accept[3]);
+
+        auto range = arbiter.validateRange(7, 1, 2, 4);
+        CHECK_EQUAL(3U, range.first);
+        CHECK_EQUAL(3U, range.count);
+    }
+
+    TEST(verifyMultiStreamSequenceArbiterSizesDynamicStreamsIndividually)
+    {
+        CountingErrorReportingPolicy errorPolicy;
+        arbiter::HistoryPool pool(1 << 16);
+        arbiter::MultiStreamSequenceArbiter<DynamicStreamTraits> arbiter(errorPolicy, 3);
+
+        arbiter.addStream(0);                                              // Traits defaults, 4 lines
+        arbiter.addStream(1, arbiter::HistoryConfig(1, 100, false, &pool));
+        arbiter.addStream(2, arbiter::HistoryConfig(2, 1000, false, &pool));
+
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(!arbiter.validate(0, 3, 0));
+
+        CHECK(arbiter.validate(1, 0, 0));
+        CHECK(arbiter.validate(1, 0, 1));   // a single line, every message is new
+
+        CHECK(arbiter.validate(2, 1, 0));
+        CHECK(!arbiter.validate(2, 0, 0));
+
+        CHECK(!arbiter.validate(1, 0, 1));
+        CHECK_EQUAL(1U, errorPolicy.duplicates);
+
+        CHECK_THROW(arbiter.addStream(1, arbiter::HistoryConfig(1, 100, false, &pool)), arbiter::DuplicateStream);
+    }
+}
@@ -0,0 +1,127 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/RaceStatistics.hpp>
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/StatsErrorReportingPolicy.hpp>
+#include <arbiter/details/ArrivalTimes.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+
+    using RacePolicy = arbiter::RaceStatistics<std::size_t, 2>;
+
+    struct RaceTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = RacePolicy;
+    };
+
+    struct TimestampedRaceTraits : public RaceTraits
+    {
+        static constexpr bool ArrivalTimestamps() { return true; }
+    };
+
+    using StatsPolicy = arbiter::StatsErrorReportingPolicy<std::size_t, 2>;
+    using ComposedPolicy = arbiter::RaceStatistics<std::size_t, 2, StatsPolicy>;
+
+    struct ComposedTraits : public RaceTraits
+    {
+        using ErrorReportingPolicy = ComposedPolicy;
+    };
+
+    TEST(verifyRaceStatisticsCountsWinsAndLagInMessages)
+    {
+        RacePolicy race;
+        arbiter::SequenceArbiter<RaceTraits> arbiter(race);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 1));
+        CHECK(arbiter.validate(0, 2));
+
+        CHECK(!arbiter.validate(1, 0));     // head is 2 ahead
+        CHECK(!arbiter.validate(1, 1));     // 1 ahead
+        CHECK(!arbiter.validate(1, 2));     // level
+
+        CHECK(arbiter.validate(1, 3));
+        CHECK(!arbiter.validate(0, 3));
+
+        CHECK_EQUAL(3U, race.wins(0));
+        CHECK_EQUAL(1U, race.wins(1));
+        CHECK_EQUAL(1U, race.losses(0));
+        CHECK_EQUAL(3U, race.losses(1));
+
+        auto lag = race.lagMessages(1);
+        CHECK_EQUAL(1U, lag[0]);
+        CHECK_EQUAL(1U, lag[1]);
+        CHECK_EQUAL(1U, lag[2]);
+
+        CHECK_EQUAL(1U, race.lagMessages(0)[0]);
+        CHECK_EQUAL(3U, race.lagTicks(1)[0]);     // no timestamps, no lag in ticks
+    }
+
+    TEST(verifyRaceStatisticsCountsGapFillsAndIgnoresDuplicates)
+    {
+        RacePolicy race;
+        arbiter::SequenceArbiter<RaceTraits> arbiter(race);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 3));      // gap of 2
+        CHECK(arbiter.validate(1, 1));      // line 1 fills the gap
+        CHECK(!arbiter.validate(0, 1));     // line 0's copy of the fill, 2 behind head
+        CHECK(!arbiter.validate(0, 1));     // duplicate on line 0, neither a win nor a loss
+
+        CHECK_EQUAL(2U, race.wins(0));
+        CHECK_EQUAL(1U, race.wins(1));
+        CHECK_EQUAL(1U, race.losses(0));
+        CHECK_EQUAL(1U, race.lagMessages(0)[2]);
+    }
+
+    TEST(verifyRaceStatisticsMeasuresLagInTicksWithArrivalTimestamps)
+    {
+        RacePolicy race;
+        arbiter::SequenceArbiter<TimestampedRaceTraits> arbiter(race);
+
+        CHECK(arbiter.validate(0, 0, 1000));
+        CHECK(arbiter.validate(0, 1, 1010));
+        CHECK(!arbiter.validate(1, 0, 1030));     // 30 ticks late
+        CHECK(!arbiter.validate(1, 1, 1031));     // 21 ticks late
+
+        const std::size_t sequences[] = {2, 3};
+        bool accept[2];
+
+        CHECK_EQUAL(2U, arbiter.validateBatch(1, sequences, 2, accept, 2000));
+        CHECK(!arbiter.validate(0, 2, 2100));     // 100 ticks late
+
+        CHECK_EQUAL(2U, race.lagTicks(1)[RacePolicy::bucket(30)]);
+        CHECK_EQUAL(1U, race.lagTicks(0)[RacePolicy::bucket(100)]);
+        CHECK_EQUAL(2U, race.wins(1));
+    }
+
+    TEST(verifyRaceStatisticsComposesWithAnotherPolicy)
+    {
+        ComposedPolicy policy;
+        arbiter::SequenceArbiter<ComposedTraits> arbiter(policy);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(!arbiter.validate(1, 0));
+        CHECK(!arbiter.validate(1, 0));     // duplicate on line 1
+
+        CHECK_EQUAL(1U, policy.wins(0));
+        CHECK_EQUAL(1U, policy.losses(1));
+        CHECK_EQUAL(1U, policy.snapshot().lines[1].duplicates);
+    }
+
+    TEST(verifyArrivalTimesCostNothingWhenDisabled)
+    {
+        CHECK(std::is_empty<arbiter::details::ArrivalTimes<false>>::value);
+        CHECK(!arbiter::details::OptionalTraits<RaceTraits>::ArrivalTimestamps());
+        CHECK(arbiter::details::OptionalTraits<TimestampedRaceTraits>::ArrivalTimestamps());
+    }
+}
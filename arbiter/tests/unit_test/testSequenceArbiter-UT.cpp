@@ -3,9 +3,18 @@
 #include <arbiter/SequenceArbiter.hpp>
 #include <arbiter/details/NullErrorReportingPolicy.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -1140,6 +1149,112 @@ namespace {
         CHECK_EQUAL(1U, overruns[0].second);    // overrun by line 1
     }
 
+    struct SixteenLineTraits : public TwoLineTraits
+    {
+        static constexpr std::size_t NumberOfLines() { return 16; }
+    };
+
+    TEST(verifySlowLineOverrunReportedForEveryLappedLine)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<SixteenLineTraits> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 5; ++sequence)
+        {
+            for(std::size_t line = 0; line < 16; ++line)
+            {
+                CHECK_EQUAL(line == 0, arbiter.validate(line, sequence));
+            }
+        }
+
+        // line 0 laps the others, sequence 14 is written over their slot.
+        for(std::size_t sequence = 5; sequence < 14; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+
+        CHECK(errorPolicy.overruns().empty());
+        CHECK(arbiter.validate(0, 14));
+
+        auto& overruns = errorPolicy.overruns();
+        REQUIRE CHECK_EQUAL(15U, overruns.size());
+
+        for(std::size_t line = 1; line < 16; ++line)
+        {
+            CHECK_EQUAL(line, overruns[line - 1].first);
+            CHECK_EQUAL(0U, overruns[line - 1].second);
+        }
+
+        // line 3 catches up, head keeps overrunning the rest one slot at a time.
+        for(std::size_t sequence = 10; sequence < 15; ++sequence)
+        {
+            arbiter.validate(3, sequence);
+        }
+
+        CHECK(arbiter.validate(0, 15));
+        CHECK_EQUAL(29U, overruns.size());
+    }
+
+    TEST(verifyForwardGapFromTheLastSlotDoesNotOverrunALine)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 10; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));     // head ends in the last slot
+        }
+
+        for(std::size_t sequence = 0; sequence < 10; ++sequence)
+        {
+            CHECK(!arbiter.validate(1, sequence));    // line 1 catches up
+        }
+
+        CHECK(arbiter.validate(0, 11));             // 10 goes in slot 0, line 1 is still in slot 9
+
+        CHECK(errorPolicy.overruns().empty());
+    }
+
+    struct NoRecoverableGapTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 0; }
+        static constexpr std::size_t NumberOfLines() { return 3; }
+        static constexpr std::size_t HistoryDepth() { return 4; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = MockErrorReportingPolicy;
+    };
+
+    TEST(verifyUnrecoverableJumpFromTheLastSlotDoesNotOverrunALine)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<NoRecoverableGapTraits> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 4; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));     // head ends in the last slot
+        }
+
+        CHECK(!arbiter.validate(1, 0));              // line 1 in slot 0, so lines are checked
+        for(std::size_t sequence = 0; sequence < 3; ++sequence)
+        {
+            CHECK(!arbiter.validate(2, sequence));    // line 2 in slot 2
+        }
+
+        // no gap slots, only head's in slot 0.
+        CHECK(arbiter.validate(0, 10));
+        CHECK_EQUAL(1U, errorPolicy.unrecoverableGaps().size());
+
+        for(const auto& overrun : errorPolicy.overruns())
+        {
+            CHECK(overrun.first != 2);
+        }
+
+        CHECK(!arbiter.validate(2, 3));
+        CHECK(arbiter.validate(2, 11));
+    }
+
     TEST(verifySequenceArbiterHandlesSlowLineOverrunOnForwardGap)
     {
         MockErrorReportingPolicy errorPolicy;
@@ -1397,4 +1512,1570 @@ namespace {
         CHECK_EQUAL(0U, overruns[1].second);    // by line 0
 
     }
+
+    TEST(verifyValidateBatchAcceptsContiguousRunsFromTwoLines)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        const std::size_t lineA[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        const std::size_t lineB[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+        bool accept[14];
+
+        CHECK_EQUAL(12U, arbiter.validateBatch(0, lineA, 12, accept));
+        for(std::size_t i = 0; i < 12; ++i)
+        {
+            CHECK(accept[i]);
+        }
+
+        // line 1 catches up to head mid-batch, then becomes head for 12 & 13.
+        CHECK_EQUAL(2U, arbiter.validateBatch(1, lineB, 14, accept));
+        for(std::size_t i = 0; i < 12; ++i)
+        {
+            CHECK(!accept[i]);
+        }
+
+        CHECK(accept[12]);
+        CHECK(accept[13]);
+
+        CHECK(!arbiter.validate(0, 12));
+        CHECK(!arbiter.validate(0, 13));
+        CHECK(arbiter.validate(0, 14));
+
+        CHECK_EQUAL(0U, errorPolicy.gaps().size());
+        CHECK_EQUAL(0U, errorPolicy.dups().size());
+    }
+
+    TEST(verifyValidateBatchHandlesGapsAndGapFillsWithinABatch)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        const std::size_t lineA[] = {0, 1, 2, 6, 7, 8};
+        const std::size_t lineB[] = {1, 2, 3, 4, 5, 6, 7, 8, 8};
+        bool accept[9];
+
+        CHECK_EQUAL(6U, arbiter.validateBatch(0, lineA, 6, accept));
+        CHECK_EQUAL(3U, arbiter.validateBatch(1, lineB, 9, accept));
+
+        const bool expected[] = {false, false, true, true, true, false, false, false, false};
+        for(std::size_t i = 0; i < 9; ++i)
+        {
+            CHECK_EQUAL(expected[i], accept[i]);
+        }
+
+        auto& gaps = errorPolicy.gaps();
+        REQUIRE CHECK_EQUAL(1U, gaps.size());
+        CHECK_EQUAL(3U, gaps[0].first);
+        CHECK_EQUAL(3U, gaps[0].second);
+
+        auto& gapFills = errorPolicy.gapFills();
+        REQUIRE CHECK_EQUAL(3U, gapFills.size());
+        CHECK_EQUAL(3U, gapFills[0].first);
+        CHECK_EQUAL(4U, gapFills[1].first);
+        CHECK_EQUAL(5U, gapFills[2].first);
+
+        auto& dups = errorPolicy.dups();
+        REQUIRE CHECK_EQUAL(1U, dups.size());
+        CHECK_EQUAL(1U, dups[0].first);
+        CHECK_EQUAL(8U, dups[0].second);
+    }
+
+    // feed the same bursts through validate() and validateBatch(), the decisions
+    // and reported errors must be identical.
+    template<class Traits>
+    void verifyBatchMatchesScalar(const std::size_t seed)
+    {
+        MockErrorReportingPolicy scalarPolicy;
+        MockErrorReportingPolicy batchPolicy;
+
+        arbiter::SequenceArbiter<Traits> scalar(scalarPolicy);
+        arbiter::SequenceArbiter<Traits> batch(batchPolicy);
+
+        std::size_t state = seed;
+        auto random = [&state](const std::size_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+        std::vector<std::size_t> next(Traits::NumberOfLines(), 0);
+        std::vector<std::size_t> burst;
+
+        for(std::size_t round = 0; round < 2000; ++round)
+        {
+            const std::size_t line = random(Traits::NumberOfLines());
+            burst.clear();
+
+            for(std::size_t i = 0, length = 1 + random(8); i < length; ++i)
+            {
+                switch(random(16))
+                {
+                    case 0: next[line] += 1 + random(4); break;               // loss
+                    case 1: next[line] -= next[line] > 3 ? random(4) : 0; break; // replay
+                    default: break;
+                }
+
+                burst.push_back(next[line]++);
+            }
+
+            std::vector<char> expected;
+            for(auto sequenceNumber : burst)
+            {
+                expected.push_back(scalar.validate(line, sequenceNumber));
+            }
+
+            std::unique_ptr<bool[]> accept(new bool[burst.size()]);
+            batch.validateBatch(line, burst.data(), burst.size(), accept.get());
+
+            for(std::size_t i = 0; i < burst.size(); ++i)
+            {
+                CHECK_EQUAL(static_cast<bool>(expected[i]), accept[i]);
+            }
+        }
+
+        CHECK(scalarPolicy.gaps() == batchPolicy.gaps());
+        CHECK(scalarPolicy.gapFills() == batchPolicy.gapFills());
+        CHECK(scalarPolicy.dups() == batchPolicy.dups());
+        CHECK(scalarPolicy.unrecoverableGaps() == batchPolicy.unrecoverableGaps());
+        CHECK(scalarPolicy.overruns() == batchPolicy.overruns());
+    }
+
+    TEST(verifyValidateBatchMatchesValidate)
+    {
+        verifyBatchMatchesScalar<SingleLineTraits>(1);
+        verifyBatchMatchesScalar<TwoLineTraits>(2);
+        verifyBatchMatchesScalar<ThreeLineTraits>(3);
+    }
+
+    template<class Traits>
+    using IsDynamic = std::integral_constant<bool, arbiter::details::ArbiterCache<Traits>::Dynamic>;
+
+    template<class Traits>
+    arbiter::SequenceArbiter<Traits>* newArbiter(MockErrorReportingPolicy& errorPolicy, std::false_type /*dynamic*/)
+    {
+        return new arbiter::SequenceArbiter<Traits>(errorPolicy);
+    }
+
+    // runtime sized arbiters are built from Traits::Config().
+    template<class Traits>
+    arbiter::SequenceArbiter<Traits>* newArbiter(MockErrorReportingPolicy& errorPolicy, std::true_type /*dynamic*/)
+    {
+        return new arbiter::SequenceArbiter<Traits>(errorPolicy, Traits::Config());
+    }
+
+    // feed the same pseudo random multi-line traffic (loss, replays, line lag and
+    // the occasional reset) through arbiters built from @ExpectedTraits and @ActualTraits,
+    // the decisions and reported errors must be identical. Both arbiters must have
+    // ExpectedTraits::NumberOfLines() lines.
+    template<class ExpectedTraits, class ActualTraits>
+    void verifyArbitersAgree(const std::size_t seed, const std::size_t rounds = 5000, const std::size_t resetEvery = 1000)
+    {
+        static_assert(ExpectedTraits::NumberOfLines() <= ActualTraits::NumberOfLines(), "arbiters must have the same number of lines");
+
+        MockErrorReportingPolicy expectedPolicy;
+        MockErrorReportingPolicy actualPolicy;
+
+        std::unique_ptr<arbiter::SequenceArbiter<ExpectedTraits>> expected(newArbiter<ExpectedTraits>(expectedPolicy, IsDynamic<ExpectedTraits>()));
+        std::unique_ptr<arbiter::SequenceArbiter<ActualTraits>> actual(newArbiter<ActualTraits>(actualPolicy, IsDynamic<ActualTraits>()));
+
+        std::size_t state = seed;
+        auto random = [&state](const std::size_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+        std::vector<std::size_t> next(ExpectedTraits::NumberOfLines(), ExpectedTraits::FirstExpectedSequenceNumber());
+
+        for(std::size_t round = 0; round < rounds; ++round)
+        {
+            if((round % resetEvery) == resetEvery - 1)
+            {
+                expected->reset();
+                actual->reset();
+
+                for(auto& sequenceNumber : next)
+                {
+                    sequenceNumber = ExpectedTraits::FirstExpectedSequenceNumber() + random(3);
+                }
+            }
+
+            const std::size_t line = random(ExpectedTraits::NumberOfLines());
+            for(std::size_t i = 0, length = 1 + random(8); i < length; ++i)
+            {
+                switch(random(32))
+                {
+                    case 0: next[line] += 1 + random(4); break;                     // loss
+                    case 1: next[line] += 1 + random(2 * ExpectedTraits::HistoryDepth()); break; // outage
+                    case 2: case 3: next[line] -= next[line] > 3 ? random(4) : 0; break;  // replay
+                    default: break;
+                }
+
+                const auto sequenceNumber = next[line]++;
+                CHECK_EQUAL(expected->validate(line, sequenceNumber), actual->validate(line, sequenceNumber));
+            }
+        }
+
+        CHECK(expectedPolicy.gaps() == actualPolicy.gaps());
+        CHECK(expectedPolicy.gapFills() == actualPolicy.gapFills());
+        CHECK(expectedPolicy.dups() == actualPolicy.dups());
+        CHECK(expectedPolicy.unrecoverableGaps() == actualPolicy.unrecoverableGaps());
+        CHECK(expectedPolicy.overruns() == actualPolicy.overruns());
+    }
+
+    TEST(verifyValidateRangeAcceptsPacketsWithoutSpuriousGaps)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        // the sequence number advances by each packet's message count.
+        auto range = arbiter.validateRange(0, 0, 3);
+        CHECK_EQUAL(0U, range.first);
+        CHECK_EQUAL(3U, range.count);
+        CHECK(range.contiguous());
+
+        range = arbiter.validateRange(0, 3, 2);
+        CHECK_EQUAL(3U, range.first);
+        CHECK_EQUAL(2U, range.count);
+
+        CHECK(arbiter.validateRange(1, 0, 3).empty());
+        CHECK(arbiter.validateRange(1, 3, 2).empty());
+
+        CHECK_EQUAL(0U, errorPolicy.gaps().size());
+        CHECK_EQUAL(0U, errorPolicy.dups().size());
+    }
+
+    TEST(verifyValidateRangeAcceptsTheUnseenPartOfAPacket)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        CHECK_EQUAL(4U, arbiter.validateRange(0, 0, 4).accepted);
+
+        // line 1 packetizes differently, 2 and 3 were seen on line 0.
+        auto range = arbiter.validateRange(1, 2, 5);
+        CHECK_EQUAL(4U, range.first);
+        CHECK_EQUAL(3U, range.count);
+        CHECK_EQUAL(3U, range.accepted);
+
+        // a gap, filled by a packet from the other line.
+        range = arbiter.validateRange(0, 9, 1);
+        CHECK_EQUAL(1U, range.accepted);
+
+        auto& gaps = errorPolicy.gaps();
+        REQUIRE CHECK_EQUAL(1U, gaps.size());
+        CHECK_EQUAL(7U, gaps[0].first);
+        CHECK_EQUAL(2U, gaps[0].second);
+
+        range = arbiter.validateRange(1, 7, 3);
+        CHECK_EQUAL(7U, range.first);
+        CHECK_EQUAL(2U, range.count);
+        CHECK_EQUAL(2U, errorPolicy.gapFills().size());
+    }
+
+    TEST(verifyValidateRangeReportsAPacketWithAHole)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        arbiter.validateRange(0, 0, 3);
+        arbiter.validateRange(0, 6, 1);         // 3 to 5 missing
+        CHECK_EQUAL(1U, arbiter.validateRange(1, 4, 1).accepted);
+
+        // line 0's retransmission of 3 to 5, 4 arrived on line 1 meanwhile.
+        auto range = arbiter.validateRange(0, 3, 3);
+        CHECK_EQUAL(3U, range.first);
+        CHECK_EQUAL(3U, range.count);
+        CHECK_EQUAL(2U, range.accepted);
+        CHECK(!range.contiguous());
+    }
+
+    TEST(verifyValidateRangeWritesAcceptedIntervals)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+        arbiter::AcceptedIntervals<std::size_t, 4> intervals;
+
+        CHECK_EQUAL(3U, arbiter.validateRange(0, 0, 3, intervals));
+        REQUIRE CHECK_EQUAL(1U, intervals.size());
+        CHECK_EQUAL(0U, intervals[0].first);
+        CHECK_EQUAL(3U, intervals[0].count);
+
+        arbiter.validateRange(0, 4, 1, intervals);      // 3 missing
+        arbiter.validateRange(0, 6, 1, intervals);      // 5 missing
+
+        // line 1 repeats 2 to 6, only the holes are new.
+        CHECK_EQUAL(2U, arbiter.validateRange(1, 2, 5, intervals));
+        REQUIRE CHECK_EQUAL(2U, intervals.size());
+        CHECK_EQUAL(3U, intervals[0].first);
+        CHECK_EQUAL(1U, intervals[0].count);
+        CHECK_EQUAL(5U, intervals[1].first);
+        CHECK_EQUAL(1U, intervals[1].count);
+        CHECK(!intervals.truncated());
+
+        CHECK_EQUAL(0U, arbiter.validateRange(0, 3, 1, intervals));
+        CHECK(intervals.empty());
+    }
+
+    TEST(verifyValidateRangeTruncatesIntervalsBeyondCapacity)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+        arbiter::AcceptedIntervals<std::size_t, 2> intervals;
+
+        for(std::size_t sequence = 0; sequence < 8; sequence += 2)
+        {
+            arbiter.validate(0, sequence);              // 1, 3, 5 missing
+        }
+
+        CHECK_EQUAL(4U, arbiter.validateRange(1, 0, 8, intervals));
+        REQUIRE CHECK_EQUAL(2U, intervals.size());
+        CHECK(intervals.truncated());
+        CHECK_EQUAL(4U, intervals.accepted());
+
+        CHECK_EQUAL(1U, intervals[0].first);
+        CHECK_EQUAL(1U, intervals[0].count);
+        CHECK_EQUAL(3U, intervals[1].first);           // 3 to 7 spans 5 and the rejected 4 and 6
+        CHECK_EQUAL(5U, intervals[1].count);
+    }
+
+    struct RangeTraits : public TwoLineTraits
+    {
+        static constexpr std::size_t LargestRecoverableGap() { return 100; }
+        static constexpr std::size_t HistoryDepth() { return 256; }
+    };
+
+    TEST(verifyValidateRangeSplitsAPartiallyDuplicatedPacket)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        std::unique_ptr<arbiter::SequenceArbiter<RangeTraits>> arbiter(new arbiter::SequenceArbiter<RangeTraits>(errorPolicy));
+        arbiter::AcceptedIntervals<std::size_t> intervals;
+
+        arbiter->validateRange(0, 0, 100, intervals);
+        arbiter->validateRange(1, 0, 100, intervals);
+
+        CHECK_EQUAL(50U, arbiter->validateRange(0, 100, 50, intervals));
+
+        // line 1's packet overlaps line 0's by 120 to 149.
+        CHECK_EQUAL(20U, arbiter->validateRange(1, 120, 50, intervals));
+        REQUIRE CHECK_EQUAL(1U, intervals.size());
+        CHECK_EQUAL(150U, intervals[0].first);
+        CHECK_EQUAL(20U, intervals[0].count);
+
+        CHECK_EQUAL(0U, errorPolicy.dups().size());
+    }
+
+    TEST(verifyValidateRangeMatchesValidateBatch)
+    {
+        MockErrorReportingPolicy rangePolicy;
+        MockErrorReportingPolicy batchPolicy;
+        MockErrorReportingPolicy intervalPolicy;
+
+        std::unique_ptr<arbiter::SequenceArbiter<RangeTraits>> ranges(new arbiter::SequenceArbiter<RangeTraits>(rangePolicy));
+        std::unique_ptr<arbiter::SequenceArbiter<RangeTraits>> batches(new arbiter::SequenceArbiter<RangeTraits>(batchPolicy));
+        std::unique_ptr<arbiter::SequenceArbiter<RangeTraits>> splits(new arbiter::SequenceArbiter<RangeTraits>(intervalPolicy));
+
+        arbiter::AcceptedIntervals<std::size_t, 128> intervals;
+        std::vector<bool> split;
+
+        std::mt19937 random(42);
+        std::size_t next[2] = {0, 0};
+
+        std::vector<std::size_t> packet;
+        std::unique_ptr<bool[]> accept(new bool[200]);
+
+        for(std::size_t i = 0; i < 2000; ++i)
+        {
+            const std::size_t line = random() % 2;
+            const std::size_t count = 1 + random() % ((i % 50 == 0) ? 150 : 8);     // some packets span several passes
+
+            switch(random() % 8)
+            {
+                case 0: next[line] += 1 + random() % 5; break;                              // loss
+                case 1: next[line] -= next[line] > 3 ? 1 + random() % 3 : 0; break;         // overlapping retransmission
+                default: break;
+            }
+
+            packet.clear();
+            for(std::size_t j = 0; j < count; ++j)
+            {
+                packet.push_back(next[line] + j);
+            }
+
+            const auto range = ranges->validateRange(line, next[line], count);
+            const auto accepted = batches->validateBatch(line, packet.data(), count, accept.get());
+
+            CHECK_EQUAL(accepted, range.accepted);
+            CHECK_EQUAL(accepted, splits->validateRange(line, next[line], count, intervals));
+
+            // the intervals mark exactly the sequence numbers validateBatch() accepts.
+            split.assign(count, false);
+            for(const auto& interval : intervals)
+            {
+                for(std::size_t j = 0; j < interval.count; ++j)
+                {
+                    split[interval.first - next[line] + j] = true;
+                }
+            }
+
+            for(std::size_t j = 0; j < count; ++j)
+            {
+                CHECK_EQUAL(accept[j], split[j]);
+            }
+
+            if(accepted != 0)
+            {
+                std::size_t first = 0;
+                while(!accept[first])
+                {
+                    ++first;
+                }
+
+                std::size_t last = count - 1;
+                while(!accept[last])
+                {
+                    --last;
+                }
+
+                CHECK_EQUAL(next[line] + first, range.first);
+                CHECK_EQUAL(last - first + 1, range.count);
+            }
+
+            next[line] += count;
+        }
+
+        CHECK(rangePolicy.gaps() == batchPolicy.gaps());
+        CHECK(rangePolicy.gapFills() == batchPolicy.gapFills());
+        CHECK(rangePolicy.dups() == batchPolicy.dups());
+        CHECK(rangePolicy.unrecoverableGaps() == batchPolicy.unrecoverableGaps());
+        CHECK(rangePolicy.overruns() == batchPolicy.overruns());
+        CHECK(intervalPolicy.gapFills() == batchPolicy.gapFills());
+        CHECK(intervalPolicy.dups() == batchPolicy.dups());
+    }
+
+    template<std::size_t Lines>
+    struct EpochResetTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return Lines; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+        static constexpr bool EpochReset() { return true; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = MockErrorReportingPolicy;
+    };
+
+    TEST(verifySequenceArbiterWithEpochResetResetsCorrectly)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<EpochResetTraits<1>> arbiter(errorPolicy);
+
+        for(std::size_t sequenceNumber = 0; sequenceNumber < 15; ++sequenceNumber)
+        {
+            CHECK(arbiter.validate(0, sequenceNumber));
+        }
+
+        CHECK(!arbiter.validate(0, 12));
+        CHECK(!arbiter.validate(0, 13));
+
+        arbiter.reset();
+
+        CHECK(arbiter.validate(0, 2));
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 1));
+        CHECK(arbiter.validate(0, 3));
+
+        CHECK(!arbiter.validate(0, 2));
+        CHECK(!arbiter.validate(0, 0));
+
+        // the stale generation must not leak unrecoverable gaps when head wraps.
+        for(std::size_t sequenceNumber = 4; sequenceNumber < 25; ++sequenceNumber)
+        {
+            CHECK(arbiter.validate(0, sequenceNumber));
+        }
+
+        CHECK_EQUAL(0U, errorPolicy.unrecoverableGaps().size());
+    }
+
+    TEST(verifySequenceArbiterWithEpochResetMatchesDefaultReset)
+    {
+        verifyArbitersAgree<SingleLineTraits, EpochResetTraits<1>>(11, 5000, 100);
+        verifyArbitersAgree<TwoLineTraits, EpochResetTraits<2>>(12, 5000, 100);
+        verifyArbitersAgree<ThreeLineTraits, EpochResetTraits<3>>(13, 5000, 100);
+    }
+
+    class LineGapErrorReportingPolicy : public MockErrorReportingPolicy
+    {
+    public:
+        void UnrecoverableLineGap(const std::size_t line, const std::size_t sequence)
+        {
+            lineGaps_.emplace_back(line, sequence);
+        }
+
+        const std::deque<LineSequencePair>& lineGaps() const { return lineGaps_; }
+
+    private:
+        std::deque<LineSequencePair> lineGaps_;
+    };
+
+    class BulkLineGapErrorReportingPolicy : public MockErrorReportingPolicy
+    {
+    public:
+        template<class LineSet>
+        void UnrecoverableLineGaps(const LineSet& missingLines, const std::size_t sequence)
+        {
+            missingLines.forEach([this, sequence](const std::size_t line) { lineGaps_.emplace_back(line, sequence); });
+            ++calls_;
+        }
+
+        const std::deque<LineSequencePair>& lineGaps() const { return lineGaps_; }
+        std::size_t calls() const { return calls_; }
+
+    private:
+        std::deque<LineSequencePair> lineGaps_;
+        std::size_t calls_ = 0;
+    };
+
+    template<class ErrorPolicy, arbiter::HistoryLayout HistoryLayout = arbiter::HistoryLayout::ArrayOfStructures>
+    struct LineGapTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 3; }
+        static constexpr std::size_t HistoryDepth() { return 4; }
+        static constexpr arbiter::HistoryLayout Layout() { return HistoryLayout; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = ErrorPolicy;
+    };
+
+    // line 0 delivers everything, line 1 only delivers 1, line 2 delivers nothing.
+    template<class Traits>
+    void deliverWithLineGaps(arbiter::SequenceArbiter<Traits>& arbiter)
+    {
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 1));
+        CHECK(!arbiter.validate(1, 1));
+        CHECK(arbiter.validate(0, 2));
+        CHECK(arbiter.validate(0, 3));
+        CHECK(arbiter.validate(0, 4));     // overwrites 0, lines 1 & 2 never reported it
+        CHECK(arbiter.validate(0, 5));     // overwrites 1, line 2 never reported it
+    }
+
+    TEST(verifyUnrecoverableLineGapsReportedPerLine)
+    {
+        LineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<LineGapErrorReportingPolicy>> arbiter(errorPolicy);
+
+        deliverWithLineGaps(arbiter);
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(3U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(2U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+    }
+
+    TEST(verifyUnrecoverableLineGapsReportedInBulk)
+    {
+        BulkLineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<BulkLineGapErrorReportingPolicy>> arbiter(errorPolicy);
+
+        deliverWithLineGaps(arbiter);
+
+        CHECK_EQUAL(2U, errorPolicy.calls());   // one call per overwritten sequence
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(3U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(2U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+    }
+
+    TEST(verifyUnrecoverableLineGapsReportedWithStructureOfArraysLayout)
+    {
+        LineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<LineGapErrorReportingPolicy, arbiter::HistoryLayout::StructureOfArrays>> arbiter(errorPolicy);
+
+        deliverWithLineGaps(arbiter);
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(3U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(2U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+    }
+
+    TEST(verifyForwardGapReportsTheIncompleteSlotsItOverwrites)
+    {
+        LineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<LineGapErrorReportingPolicy>> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 4; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+
+        CHECK(!arbiter.validate(1, 2));
+
+        // 4 missing, the jump overwrites 0 and 1 which lines 1 & 2 never reported.
+        CHECK(arbiter.validate(0, 5));
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(4U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(1U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+        CHECK_EQUAL(2U, lineGaps[3].first);
+        CHECK_EQUAL(1U, lineGaps[3].second);
+        CHECK(errorPolicy.unrecoverableGaps().empty());
+
+        // 6 & 7 missing, the jump wraps over 2, 3 and the slot of the gap at 4.
+        CHECK(arbiter.validate(0, 8));
+
+        REQUIRE CHECK_EQUAL(7U, lineGaps.size());
+
+        CHECK_EQUAL(2U, lineGaps[4].first);
+        CHECK_EQUAL(2U, lineGaps[4].second);
+        CHECK_EQUAL(1U, lineGaps[5].first);
+        CHECK_EQUAL(3U, lineGaps[5].second);
+        CHECK_EQUAL(2U, lineGaps[6].first);
+        CHECK_EQUAL(3U, lineGaps[6].second);
+
+        auto& unrecoverable = errorPolicy.unrecoverableGaps();
+        REQUIRE CHECK_EQUAL(1U, unrecoverable.size());
+
+        CHECK_EQUAL(4U, unrecoverable[0].first);
+        CHECK_EQUAL(1U, unrecoverable[0].second);
+    }
+
+    template<class ErrorPolicy>
+    struct LimitedJumpTraits : public LineGapTraits<ErrorPolicy>
+    {
+        static constexpr std::size_t LargestRecoverableGap() { return 1; }
+    };
+
+    TEST(verifyUnrecoverableJumpReportsTheIncompleteSlotsItOverwrites)
+    {
+        LineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LimitedJumpTraits<LineGapErrorReportingPolicy>> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 4; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));     // head ends in the last slot
+            if(sequence < 2)
+            {
+                CHECK(!arbiter.validate(1, sequence));
+            }
+        }
+
+        CHECK(!arbiter.validate(2, 0));
+
+        // 4 to 8 are beyond the largest recoverable gap, 9 is kept. Only 9's slot and
+        // head's are overwritten, wrapped to slots 0 & 1.
+        CHECK(arbiter.validate(0, 10));
+
+        auto& unrecoverable = errorPolicy.unrecoverableGaps();
+        REQUIRE CHECK_EQUAL(1U, unrecoverable.size());
+
+        CHECK_EQUAL(4U, unrecoverable[0].first);
+        CHECK_EQUAL(5U, unrecoverable[0].second);
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(1U, lineGaps.size());
+
+        CHECK_EQUAL(2U, lineGaps[0].first);
+        CHECK_EQUAL(1U, lineGaps[0].second);
+
+        CHECK(!arbiter.validate(1, 2));     // 2 & 3 keep their slots
+        CHECK(arbiter.validate(1, 9));
+    }
+
+    TEST(verifyForwardGapReportsTheSlotsItOverwritesInBulk)
+    {
+        BulkLineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<BulkLineGapErrorReportingPolicy>> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 4; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+
+        CHECK(!arbiter.validate(1, 1));
+        CHECK(arbiter.validate(0, 5));
+
+        CHECK_EQUAL(2U, errorPolicy.calls());   // one call per overwritten sequence
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(3U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(2U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+    }
+
+    template<std::size_t Lines, arbiter::HistoryLayout HistoryLayout>
+    struct LayoutTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return Lines; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+        static constexpr arbiter::HistoryLayout Layout() { return HistoryLayout; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = MockErrorReportingPolicy;
+    };
+
+    TEST(verifySequenceArbiterWithStructureOfArraysLayoutMatchesDefault)
+    {
+        using arbiter::HistoryLayout;
+
+        verifyArbitersAgree<SingleLineTraits, LayoutTraits<1, HistoryLayout::StructureOfArrays>>(21);
+        verifyArbitersAgree<TwoLineTraits, LayoutTraits<2, HistoryLayout::StructureOfArrays>>(22);
+        verifyArbitersAgree<ThreeLineTraits, LayoutTraits<3, HistoryLayout::StructureOfArrays>>(23);
+        verifyArbitersAgree<LayoutTraits<9, HistoryLayout::ArrayOfStructures>, LayoutTraits<9, HistoryLayout::StructureOfArrays>>(24);
+    }
+
+    TEST(verifyUnrecoverableLineGapsReportedWithImplicitSequenceLayout)
+    {
+        LineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<LineGapErrorReportingPolicy, arbiter::HistoryLayout::ImplicitSequence>> arbiter(errorPolicy);
+
+        deliverWithLineGaps(arbiter);
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(3U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(2U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+    }
+
+    template<std::size_t Lines, std::size_t Gap, arbiter::HistoryLayout HistoryLayout>
+    struct ImplicitTraits : public LayoutTraits<Lines, HistoryLayout>
+    {
+        static constexpr std::size_t LargestRecoverableGap() { return Gap; }
+    };
+
+    TEST(verifySequenceArbiterWithImplicitSequenceLayoutMatchesDefault)
+    {
+        using arbiter::HistoryLayout;
+
+        verifyArbitersAgree<SingleLineTraits, LayoutTraits<1, HistoryLayout::ImplicitSequence>>(31);
+        verifyArbitersAgree<TwoLineTraits, LayoutTraits<2, HistoryLayout::ImplicitSequence>>(32);
+        verifyArbitersAgree<ThreeLineTraits, LayoutTraits<3, HistoryLayout::ImplicitSequence>>(33);
+
+        // every forward gap is unrecoverable, so the history holds many jumps in sequence.
+        verifyArbitersAgree<ImplicitTraits<2, 0, HistoryLayout::ArrayOfStructures>, ImplicitTraits<2, 0, HistoryLayout::ImplicitSequence>>(34);
+        verifyArbitersAgree<ImplicitTraits<3, 1, HistoryLayout::ArrayOfStructures>, ImplicitTraits<3, 1, HistoryLayout::ImplicitSequence>>(35);
+
+        // gaps longer than the history.
+        verifyArbitersAgree<ImplicitTraits<2, 25, HistoryLayout::ArrayOfStructures>, ImplicitTraits<2, 25, HistoryLayout::ImplicitSequence>>(36);
+    }
+
+    TEST(verifySequenceArbiterWithImplicitSequenceLayoutKeepsSequencesBeforeAJump)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LayoutTraits<2, arbiter::HistoryLayout::ImplicitSequence>> arbiter(errorPolicy);
+
+        for(std::size_t sequence = 0; sequence < 4; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+
+        CHECK(arbiter.validate(0, 100));    // unrecoverable gap, 95 - 99 recoverable
+
+        // line 1 still sees the sequences written before the jump.
+        CHECK(!arbiter.validate(1, 0));
+        CHECK(!arbiter.validate(1, 1));
+        CHECK(arbiter.validate(1, 95));
+
+        CHECK_EQUAL(0U, errorPolicy.dups().size());
+    }
+
+    // runtime sized arbiter with up to 8 lines, configured with @Lines lines and @Depth history.
+    template<std::size_t Lines, std::size_t Depth>
+    struct DynamicTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 0; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 8; }
+        static constexpr std::size_t HistoryDepth() { return 64; }
+        static constexpr arbiter::HistoryLayout Layout() { return arbiter::HistoryLayout::Dynamic; }
+
+        static arbiter::HistoryConfig Config() { return arbiter::HistoryConfig(Lines, Depth); }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = MockErrorReportingPolicy;
+    };
+
+    template<std::size_t Lines, std::size_t Depth>
+    struct StaticTraits : public LayoutTraits<Lines, arbiter::HistoryLayout::ArrayOfStructures>
+    {
+        static constexpr std::size_t HistoryDepth() { return Depth; }
+    };
+
+    TEST(verifySequenceArbiterWithDynamicLayoutMatchesDefault)
+    {
+        verifyArbitersAgree<SingleLineTraits, DynamicTraits<1, 10>>(41);
+        verifyArbitersAgree<TwoLineTraits, DynamicTraits<2, 10>>(42);
+        verifyArbitersAgree<ThreeLineTraits, DynamicTraits<3, 10>>(43);
+
+        // power of two depth wraps with a mask.
+        verifyArbitersAgree<StaticTraits<2, 16>, DynamicTraits<2, 16>>(44);
+        verifyArbitersAgree<StaticTraits<8, 7>, DynamicTraits<8, 7>>(45);
+    }
+
+    TEST(verifySequenceArbiterWithDynamicLayoutReportsConfiguredLinesOnly)
+    {
+        LineGapErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<LineGapTraits<LineGapErrorReportingPolicy, arbiter::HistoryLayout::Dynamic>> arbiter(errorPolicy, arbiter::HistoryConfig(3, 4));
+
+        deliverWithLineGaps(arbiter);
+
+        auto& lineGaps = errorPolicy.lineGaps();
+        REQUIRE CHECK_EQUAL(3U, lineGaps.size());
+
+        CHECK_EQUAL(1U, lineGaps[0].first);
+        CHECK_EQUAL(0U, lineGaps[0].second);
+        CHECK_EQUAL(2U, lineGaps[1].first);
+        CHECK_EQUAL(0U, lineGaps[1].second);
+        CHECK_EQUAL(2U, lineGaps[2].first);
+        CHECK_EQUAL(1U, lineGaps[2].second);
+    }
+
+    TEST(verifySequenceArbiterWithDynamicLayoutRejectsInvalidConfig)
+    {
+        using Arbiter = arbiter::SequenceArbiter<DynamicTraits<2, 10>>;
+        MockErrorReportingPolicy errorPolicy;
+
+        CHECK_THROW(Arbiter(errorPolicy, arbiter::HistoryConfig(0, 10)), arbiter::InvalidHistoryConfig);
+        CHECK_THROW(Arbiter(errorPolicy, arbiter::HistoryConfig(9, 10)), arbiter::InvalidHistoryConfig);
+        CHECK_THROW(Arbiter(errorPolicy, arbiter::HistoryConfig(2, 0)), arbiter::InvalidHistoryConfig);
+    }
+
+    TEST(verifySequenceArbiterWithDynamicLayoutAllocatesFromHistoryPool)
+    {
+        using Arbiter = arbiter::SequenceArbiter<DynamicTraits<2, 10>>;
+        using History = arbiter::details::ArbiterCache<DynamicTraits<2, 10>>::History;
+
+        const arbiter::HistoryConfig small(2, 100);
+        const arbiter::HistoryConfig large(2, 1000);
+
+        arbiter::HistoryPool pool(History::bytes(small) + History::bytes(large));
+        MockErrorReportingPolicy errorPolicy;
+
+        Arbiter first(errorPolicy, arbiter::HistoryConfig(2, 100, false, &pool));
+        Arbiter second(errorPolicy, arbiter::HistoryConfig(2, 1000, false, &pool));
+        CHECK_EQUAL(pool.capacity(), pool.used());
+
+        CHECK(first.validate(0, 0));
+        CHECK(second.validate(0, 0));
+        CHECK(!first.validate(1, 0));
+        CHECK(!second.validate(1, 0));
+
+        CHECK_THROW(Arbiter(errorPolicy, arbiter::HistoryConfig(2, 1, false, &pool)), std::bad_alloc);
+    }
+
+    TEST(verifySequenceArbiterWithDynamicLayoutOnHugePages)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<DynamicTraits<2, 10>> arbiter(errorPolicy, arbiter::HistoryConfig(2, 1 << 16, true));
+
+        for(std::size_t sequence = 0; sequence < (1 << 17); ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+            CHECK(!arbiter.validate(1, sequence));
+        }
+    }
+
+    // runtime sized arbiter with arrival timestamps, its history grows from @Depth up to @MaxDepth
+    // slots to keep slots some line is missing for at least @MinimumAge ticks.
+    template<std::size_t Lines, std::size_t Depth, std::size_t MaxDepth, std::uint64_t MinimumAge>
+    struct TimeBoundedTraits : public DynamicTraits<Lines, Depth>
+    {
+        static constexpr bool ArrivalTimestamps() { return true; }
+
+        static arbiter::HistoryConfig Config()
+        {
+            arbiter::HistoryConfig config(Lines, Depth);
+            config.maxHistoryDepth = MaxDepth;
+            config.minimumAge = MinimumAge;
+
+            return config;
+        }
+    };
+
+    TEST(verifyTimeBoundedHistoryGrowsToKeepYoungGaps)
+    {
+        using Traits = TimeBoundedTraits<2, 8, 32, 100>;
+
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy, Traits::Config());
+
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(arbiter.validate(0, 2, 0));       // 1 missing
+
+        // a burst on line 0 sweeps through 8 slots within the minimum age.
+        for(std::size_t sequence = 3; sequence < 20; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence, 10));
+        }
+
+        CHECK_EQUAL(32U, arbiter.historyDepth());
+        CHECK(errorPolicy.unrecoverableGaps().empty());
+
+        // line 1 catches up, filling the gap.
+        for(std::size_t sequence = 0; sequence < 20; ++sequence)
+        {
+            CHECK_EQUAL(sequence == 1, arbiter.validate(1, sequence, 50));
+        }
+
+        CHECK_EQUAL(1U, errorPolicy.gapFills().size());
+        CHECK(errorPolicy.overruns().empty());
+
+        // gaps older than the minimum age are overwritten by depth.
+        CHECK(arbiter.validate(0, 21, 200));
+        for(std::size_t sequence = 22; sequence < 60; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence, 300));
+            CHECK(!arbiter.validate(1, sequence, 300));
+        }
+
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.unrecoverableGaps().size());
+        CHECK_EQUAL(20U, errorPolicy.unrecoverableGaps()[0].first);
+        CHECK_EQUAL(32U, arbiter.historyDepth());
+
+        arbiter.reset();
+        CHECK_EQUAL(8U, arbiter.historyDepth());
+    }
+
+    TEST(verifyTimeBoundedHistoryStopsGrowingAtMaxHistoryDepth)
+    {
+        using Traits = TimeBoundedTraits<2, 8, 20, 100>;
+
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy, Traits::Config());
+
+        CHECK(arbiter.validate(0, 0, 0));
+        CHECK(arbiter.validate(0, 2, 0));
+
+        for(std::size_t sequence = 3; sequence < 30; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence, 10));
+        }
+
+        CHECK_EQUAL(20U, arbiter.historyDepth());   // 8, 16, then the remaining 4
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.unrecoverableGaps().size());
+        CHECK_EQUAL(1U, errorPolicy.unrecoverableGaps()[0].first);
+    }
+
+    TEST(verifyTimeBoundedHistoryKeepsALaggingLine)
+    {
+        using Traits = TimeBoundedTraits<3, 8, 4096, std::numeric_limits<std::uint64_t>::max()>;
+
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy, Traits::Config());
+
+        std::size_t state = 71;
+        auto random = [&state](const std::size_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+        // every sequence is carried by at least one line, lines lag each other by far more than 8.
+        constexpr std::size_t Sequences = 2000;
+        std::vector<std::size_t> next(3, 0);
+        std::vector<std::size_t> accepted(Sequences, 0);
+
+        while((next[0] < Sequences) || (next[1] < Sequences) || (next[2] < Sequences))
+        {
+            const std::size_t pick = random(10);
+            const std::size_t line = pick < 6 ? 0 : (pick < 9 ? 1 : 2);
+            if(next[line] >= Sequences)
+            {
+                continue;
+            }
+
+            const std::size_t sequence = next[line]++;
+            if((line != 2) && (random(8) == 0))
+            {
+                continue;   // lost on lines 0 and 1, line 2 carries everything
+            }
+
+            if(arbiter.validate(line, sequence, sequence))
+            {
+                ++accepted[sequence];
+            }
+        }
+
+        for(std::size_t sequence = 0; sequence < Sequences; ++sequence)
+        {
+            CHECK_EQUAL(1U, accepted[sequence]);
+        }
+
+        CHECK(errorPolicy.unrecoverableGaps().empty());
+        CHECK(errorPolicy.overruns().empty());
+        CHECK(arbiter.historyDepth() > 8U);
+    }
+
+    TEST(verifyTimeBoundedHistoryRejectsInvalidConfig)
+    {
+        MockErrorReportingPolicy errorPolicy;
+
+        auto smaller = TimeBoundedTraits<2, 8, 8, 100>::Config();
+        smaller.maxHistoryDepth = 4;
+        CHECK_THROW((arbiter::SequenceArbiter<TimeBoundedTraits<2, 8, 8, 100>>(errorPolicy, smaller)), arbiter::InvalidHistoryConfig);
+
+        // without arrival timestamps there's no age to bound.
+        auto aged = DynamicTraits<2, 8>::Config();
+        aged.minimumAge = 100;
+        CHECK_THROW((arbiter::SequenceArbiter<DynamicTraits<2, 8>>(errorPolicy, aged)), arbiter::InvalidHistoryConfig);
+    }
+
+    // runtime sized arbiter whose history adapts between @Depth and @MaxDepth slots to the 99th
+    // percentile of line lag, with a headroom of 1.5, over windows of @Interval head advances.
+    template<std::size_t Lines, std::size_t Depth, std::size_t MaxDepth, std::size_t Interval = 16>
+    struct AdaptiveTraits : public DynamicTraits<Lines, Depth>
+    {
+        static arbiter::HistoryConfig Config()
+        {
+            arbiter::HistoryConfig config(Lines, Depth);
+            config.maxHistoryDepth = MaxDepth;
+            config.lagPercentile = 0.99;
+            config.lagHeadroom = 1.5;
+            config.adaptInterval = Interval;
+
+            return config;
+        }
+    };
+
+    TEST(verifyAdaptiveHistoryFollowsLineLag)
+    {
+        using Traits = AdaptiveTraits<2, 8, 64>;
+
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy, Traits::Config());
+
+        // line 1 trails line 0 by 12.
+        for(std::size_t sequence = 0; sequence < 100; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+            if(sequence >= 12)
+            {
+                CHECK(!arbiter.validate(1, sequence - 12));
+            }
+        }
+
+        CHECK_EQUAL(32U, arbiter.historyDepth());
+        CHECK(errorPolicy.overruns().empty());
+
+        // line 1 catches up, then both lose 150.
+        for(std::size_t sequence = 88; sequence < 100; ++sequence)
+        {
+            CHECK(!arbiter.validate(1, sequence));
+        }
+
+        for(std::size_t sequence = 100; sequence < 300; ++sequence)
+        {
+            if(sequence != 150)
+            {
+                CHECK(arbiter.validate(0, sequence));
+                CHECK(!arbiter.validate(1, sequence));
+            }
+        }
+
+        CHECK_EQUAL(8U, arbiter.historyDepth());
+        CHECK(errorPolicy.overruns().empty());
+
+        // dropped by a shrink or overwritten by head, reported once either way.
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.unrecoverableGaps().size());
+        CHECK_EQUAL(150U, errorPolicy.unrecoverableGaps()[0].first);
+    }
+
+    TEST(verifyAdaptiveHistoryGrowsAndShrinksWithoutLosingMessages)
+    {
+        using Traits = AdaptiveTraits<3, 8, 1024>;
+
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy, Traits::Config());
+
+        std::size_t state = 73;
+        auto random = [&state](const std::size_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+        // blocks of 256 sequences delivered either in lockstep or one line after another, line 2
+        // carries everything. Lag swings between a few slots and a block, the last blocks are quiet.
+        constexpr std::size_t Block = 256;
+        constexpr std::size_t Blocks = 24;
+
+        std::vector<std::size_t> accepted(Block * Blocks, 0);
+        std::size_t deepest = 0;
+
+        auto deliver = [&](const std::size_t line, const std::size_t sequence)
+        {
+            if((line == 2) || (random(8) != 0))
+            {
+                accepted[sequence] += arbiter.validate(line, sequence) ? 1 : 0;
+                deepest = arbiter.historyDepth() > deepest ? arbiter.historyDepth() : deepest;
+            }
+        };
+
+        for(std::size_t block = 0; block < Blocks; ++block)
+        {
+            const bool skewed = (block < Blocks - 4) && (random(2) == 0);
+            for(std::size_t line = 0; skewed && (line < 3); ++line)
+            {
+                for(std::size_t sequence = block * Block; sequence < (block + 1) * Block; ++sequence)
+                {
+                    deliver(line, sequence);
+                }
+            }
+
+            for(std::size_t sequence = block * Block; !skewed && (sequence < (block + 1) * Block); ++sequence)
+            {
+                for(std::size_t line = 0; line < 3; ++line)
+                {
+                    deliver(line, sequence);
+                }
+            }
+        }
+
+        for(std::size_t sequence = 0; sequence < accepted.size(); ++sequence)
+        {
+            CHECK_EQUAL(1U, accepted[sequence]);
+        }
+
+        CHECK(errorPolicy.unrecoverableGaps().empty());
+        CHECK(errorPolicy.overruns().empty());
+
+        CHECK(deepest >= 512U);
+        CHECK_EQUAL(8U, arbiter.historyDepth());
+    }
+
+    TEST(verifyAdaptiveHistoryDropsSlotsAFewPerAdvance)
+    {
+        using Traits = AdaptiveTraits<2, 64, 1024, 256>;
+        using Cache = arbiter::details::ArbiterCache<Traits>;
+
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy, Traits::Config());
+
+        // line 1 trails line 0 by 300, then catches up.
+        std::size_t sequence = 0;
+        for(; sequence < 2000; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+            if(sequence >= 300)
+            {
+                CHECK(!arbiter.validate(1, sequence - 300));
+            }
+        }
+
+        for(std::size_t behind = 1700; behind < 2000; ++behind)
+        {
+            CHECK(!arbiter.validate(1, behind));
+        }
+
+        CHECK_EQUAL(512U, arbiter.historyDepth());
+
+        // every fourth sequence, the history shrinks back to 64 slots dropping three gaps in four.
+        std::size_t most = 0;
+        for(; sequence < 20000; sequence += 4)
+        {
+            for(std::size_t line = 0; line < 2; ++line)
+            {
+                const auto reported = errorPolicy.unrecoverableGaps().size();
+                CHECK_EQUAL(line == 0, arbiter.validate(line, sequence));
+
+                most = std::max(most, errorPolicy.unrecoverableGaps().size() - reported);
+            }
+        }
+
+        CHECK_EQUAL(64U, arbiter.historyDepth());
+        CHECK(errorPolicy.overruns().empty());
+
+        // the 192 gaps of a 512 slot history's half weren't reported in one go.
+        CHECK(most <= Cache::ResizeStep);
+
+        // each once, up to the gaps in the history. Those dropped ahead of head come before older
+        // ones head overwrites.
+        std::vector<std::size_t> reported;
+        for(const auto& gap : errorPolicy.unrecoverableGaps())
+        {
+            reported.push_back(gap.first);
+        }
+
+        std::sort(reported.begin(), reported.end());
+
+        std::size_t expected = 2001;
+        for(const auto gap : reported)
+        {
+            CHECK_EQUAL(expected, gap);
+            expected += (expected % 4 == 3) ? 2 : 1;
+        }
+
+        CHECK(expected + 4 * 64 >= sequence);
+    }
+
+    TEST(verifyAdaptiveHistoryRejectsInvalidConfig)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        using Arbiter = arbiter::SequenceArbiter<AdaptiveTraits<2, 8, 64>>;
+
+        auto percentile = AdaptiveTraits<2, 8, 64>::Config();
+        percentile.lagPercentile = 1.5;
+        CHECK_THROW(Arbiter(errorPolicy, percentile), arbiter::InvalidHistoryConfig);
+
+        auto headroom = AdaptiveTraits<2, 8, 64>::Config();
+        headroom.lagHeadroom = 0.5;
+        CHECK_THROW(Arbiter(errorPolicy, headroom), arbiter::InvalidHistoryConfig);
+
+        auto interval = AdaptiveTraits<2, 8, 64>::Config();
+        interval.adaptInterval = 0;
+        CHECK_THROW(Arbiter(errorPolicy, interval), arbiter::InvalidHistoryConfig);
+    }
+
+    struct ByValueTraits : public TwoLineTraits
+    {
+        static constexpr bool ErrorReportingPolicyByValue() { return true; }
+    };
+
+    TEST(verifySequenceArbiterHoldsErrorReportingPolicyByValue)
+    {
+        arbiter::SequenceArbiter<ByValueTraits> arbiter;
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(!arbiter.validate(0, 0));
+        CHECK(arbiter.validate(1, 2));
+
+        REQUIRE CHECK_EQUAL(1U, arbiter.errorPolicy().dups().size());
+        CHECK_EQUAL(1U, arbiter.errorPolicy().gaps().size());
+    }
+
+    TEST(verifySequenceArbiterCopiesErrorReportingPolicyHeldByValue)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<ByValueTraits> arbiter(errorPolicy);
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(!arbiter.validate(0, 0));
+
+        CHECK_EQUAL(0U, errorPolicy.dups().size());
+        CHECK_EQUAL(1U, arbiter.errorPolicy().dups().size());
+        CHECK(&errorPolicy != &arbiter.errorPolicy());
+    }
+
+    TEST(verifySequenceArbiterReturnsErrorReportingPolicyHeldByReference)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+
+        CHECK_EQUAL(&errorPolicy, &arbiter.errorPolicy());
+    }
+
+    template<class Deque>
+    Deque since(const Deque& reports, const std::size_t count)
+    {
+        return Deque(reports.begin() + count, reports.end());
+    }
+
+    // @Traits tracking the slots changed since a snapshot.
+    template<class Traits>
+    struct Incremental : public Traits
+    {
+        static constexpr bool IncrementalSnapshots() { return true; }
+    };
+
+    // feed pseudo random traffic on @lines lines to a primary arbiter, checkpointing it into
+    // one snapshot buffer every @checkpointEvery rounds. A standby restored from the last
+    // checkpoint then takes the rest of the traffic, its decisions and reported errors
+    // must match the primary's from the checkpoint on. A twin taking the same traffic is
+    // snapshotted in full at each checkpoint, the primary's image must match it.
+    template<class Traits>
+    void verifyStandbyResumesFromSnapshot(const std::size_t seed, const std::size_t lines = Traits::NumberOfLines(), const std::size_t rounds = 3000, const std::size_t checkpointEvery = 100)
+    {
+        MockErrorReportingPolicy primaryPolicy;
+        MockErrorReportingPolicy standbyPolicy;
+        MockErrorReportingPolicy twinPolicy;
+
+        std::unique_ptr<arbiter::SequenceArbiter<Traits>> primary(newArbiter<Traits>(primaryPolicy, IsDynamic<Traits>()));
+        std::unique_ptr<arbiter::SequenceArbiter<Traits>> standby(newArbiter<Traits>(standbyPolicy, IsDynamic<Traits>()));
+        std::unique_ptr<arbiter::SequenceArbiter<Traits>> twin(newArbiter<Traits>(twinPolicy, IsDynamic<Traits>()));
+
+        std::vector<unsigned char> buffer(primary->snapshotSize());
+
+        std::size_t state = seed;
+        auto random = [&state](const std::size_t range) { state = state * 6364136223846793005ULL + 1442695040888963407ULL; return (state >> 33) % range; };
+
+        std::vector<std::size_t> next(lines, Traits::FirstExpectedSequenceNumber());
+        const std::size_t failover = rounds / 2 - (rounds / 2) % checkpointEvery;
+
+        std::size_t gaps = 0, gapFills = 0, dups = 0, unrecoverableGaps = 0, overruns = 0;
+
+        for(std::size_t round = 0; round < rounds; ++round)
+        {
+            if((round % checkpointEvery) == 0)
+            {
+                primary->snapshot(buffer.data());
+
+                // all but the generation (bytes 8 to 15).
+                std::vector<unsigned char> full(buffer.size());
+                twin->snapshot(full.data());
+
+                CHECK(std::equal(buffer.begin(), buffer.begin() + 8, full.begin()));
+                CHECK(std::equal(buffer.begin() + 16, buffer.end(), full.begin() + 16));
+            }
+
+            if(round == failover)
+            {
+                standby->restore(buffer.data());
+
+                gaps = primaryPolicy.gaps().size();
+                gapFills = primaryPolicy.gapFills().size();
+                dups = primaryPolicy.dups().size();
+                unrecoverableGaps = primaryPolicy.unrecoverableGaps().size();
+                overruns = primaryPolicy.overruns().size();
+            }
+
+            const std::size_t line = random(next.size());
+            for(std::size_t i = 0, length = 1 + random(8); i < length; ++i)
+            {
+                switch(random(32))
+                {
+                    case 0: next[line] += 1 + random(4); break;
+                    case 1: next[line] += 1 + random(2 * Traits::HistoryDepth()); break;
+                    case 2: case 3: next[line] -= next[line] > 3 ? random(4) : 0; break;
+                    default: break;
+                }
+
+                const auto sequenceNumber = next[line]++;
+                const bool accepted = primary->validate(line, sequenceNumber);
+                twin->validate(line, sequenceNumber);
+
+                if(round >= failover)
+                {
+                    CHECK_EQUAL(accepted, standby->validate(line, sequenceNumber));
+                }
+            }
+        }
+
+        CHECK(since(primaryPolicy.gaps(), gaps) == standbyPolicy.gaps());
+        CHECK(since(primaryPolicy.gapFills(), gapFills) == standbyPolicy.gapFills());
+        CHECK(since(primaryPolicy.dups(), dups) == standbyPolicy.dups());
+        CHECK(since(primaryPolicy.unrecoverableGaps(), unrecoverableGaps) == standbyPolicy.unrecoverableGaps());
+        CHECK(since(primaryPolicy.overruns(), overruns) == standbyPolicy.overruns());
+    }
+
+    // as above, with whole and incremental snapshots.
+    template<class Traits, class... Args>
+    void verifyStandbyResumesFromSnapshots(Args... args)
+    {
+        verifyStandbyResumesFromSnapshot<Traits>(args...);
+        verifyStandbyResumesFromSnapshot<Incremental<Traits>>(args...);
+    }
+
+    TEST(verifyStandbyResumesFromSnapshot)
+    {
+        using arbiter::HistoryLayout;
+
+        verifyStandbyResumesFromSnapshots<TwoLineTraits>(51);
+        verifyStandbyResumesFromSnapshots<ThreeLineTraits>(52);
+        verifyStandbyResumesFromSnapshots<LayoutTraits<9, HistoryLayout::ArrayOfStructures>>(53);
+        verifyStandbyResumesFromSnapshots<LayoutTraits<3, HistoryLayout::StructureOfArrays>>(54);
+        verifyStandbyResumesFromSnapshots<LayoutTraits<2, HistoryLayout::ImplicitSequence>>(55);
+        verifyStandbyResumesFromSnapshots<ImplicitTraits<3, 1, HistoryLayout::ImplicitSequence>>(56);
+        verifyStandbyResumesFromSnapshots<DynamicTraits<3, 10>>(57, 3);
+        verifyStandbyResumesFromSnapshots<EpochResetTraits<2>>(58);
+
+        // validated without timestamps every slot is young, the history grows to its max depth.
+        verifyStandbyResumesFromSnapshots<TimeBoundedTraits<3, 10, 80, 1>>(59, 3);
+
+        // checkpoints closer than the history depth, written in part.
+        verifyStandbyResumesFromSnapshots<DynamicTraits<3, 64>>(60, 3, 3000, 1);
+        verifyStandbyResumesFromSnapshots<DynamicTraits<5, 64>>(61, 5, 3000, 3);
+        verifyStandbyResumesFromSnapshots<AdaptiveTraits<3, 8, 64>>(62, 3, 3000, 2);
+        verifyStandbyResumesFromSnapshots<LayoutTraits<2, HistoryLayout::ImplicitSequence>>(63, 2, 3000, 1);
+    }
+
+    // whole or incremental, a snapshot rewrites only the slots which changed.
+    template<class Traits>
+    void verifySnapshotWritesOnlyChangedSlots()
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits> arbiter(errorPolicy);
+
+        std::vector<unsigned char> buffer(arbiter.snapshotSize());
+
+        CHECK_EQUAL(Traits::HistoryDepth(), arbiter.snapshot(buffer.data()));     // a new buffer is written in full
+        CHECK_EQUAL(0U, arbiter.snapshot(buffer.data()));
+
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 1));
+        CHECK_EQUAL(2U, arbiter.snapshot(buffer.data()));
+
+        CHECK(!arbiter.validate(1, 1));
+        CHECK_EQUAL(1U, arbiter.snapshot(buffer.data()));
+        CHECK_EQUAL(0U, arbiter.snapshot(buffer.data()));
+    }
+
+    TEST(verifySnapshotWritesOnlyChangedSlots)
+    {
+        verifySnapshotWritesOnlyChangedSlots<TwoLineTraits>();
+        verifySnapshotWritesOnlyChangedSlots<Incremental<TwoLineTraits>>();
+    }
+
+    TEST(verifySnapshotRestoresAnArbiterWhichHasNotStarted)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> primary(errorPolicy);
+        arbiter::SequenceArbiter<TwoLineTraits> standby(errorPolicy);
+
+        std::vector<unsigned char> buffer(primary.snapshotSize());
+        primary.snapshot(buffer.data());
+
+        CHECK(standby.validate(0, 0));
+        standby.restore(buffer.data());
+
+        CHECK(standby.validate(1, 0));      // the first message again
+    }
+
+    TEST(verifySnapshotRestoreRejectsInvalidSnapshots)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> arbiter(errorPolicy);
+        arbiter::SequenceArbiter<ThreeLineTraits> other(errorPolicy);
+
+        std::vector<unsigned char> buffer(other.snapshotSize());
+        CHECK_THROW(arbiter.restore(buffer.data()), arbiter::InvalidSnapshot);
+
+        other.snapshot(buffer.data());
+        CHECK_THROW(arbiter.restore(buffer.data()), arbiter::InvalidSnapshot);
+
+        arbiter.snapshot(buffer.data());
+        buffer[8] ^= 1;                     // the generation, odd while a snapshot is being written
+        CHECK_THROW(arbiter.restore(buffer.data()), arbiter::InvalidSnapshot);
+    }
+
+    TEST(verifySnapshotRestoreRejectsOutOfRangePositions)
+    {
+        MockErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<TwoLineTraits> primary(errorPolicy);
+        arbiter::SequenceArbiter<TwoLineTraits> standby(errorPolicy);
+
+        CHECK(primary.validate(0, 0));
+        CHECK(primary.validate(0, 1));
+
+        std::vector<unsigned char> buffer(primary.snapshotSize());
+        primary.snapshot(buffer.data());
+
+        const std::size_t headOffset = 40;                          // magic, sequence bytes, generation, lines, depths
+        const std::size_t positionsOffset = headOffset + 8;
+
+        auto image = buffer;
+        image[headOffset] = 2;                                      // two lines, head is 0 or 1
+        CHECK_THROW(standby.restore(image.data()), arbiter::InvalidSnapshot);
+
+        image = buffer;
+        image[positionsOffset + 8] = TwoLineTraits::HistoryDepth(); // line 1's position, one past the last slot
+        CHECK_THROW(standby.restore(image.data()), arbiter::InvalidSnapshot);
+
+        image = buffer;
+        image[positionsOffset + 15] = 0x80;                         // line 1's position, its top byte
+        CHECK_THROW(standby.restore(image.data()), arbiter::InvalidSnapshot);
+
+        // a rejected snapshot leaves the standby as it was, not started.
+        CHECK(standby.validate(1, 0));
+
+        standby.restore(buffer.data());
+        CHECK(!standby.validate(1, 1));
+        CHECK(standby.validate(1, 2));
+    }
+    struct SnapshotRaceTraits : public TwoLineTraits
+    {
+        static constexpr std::size_t HistoryDepth() { return 4096; }
+    };
+
+    // an image of @arbiter but for its generation (bytes 8 to 15).
+    template<class Arbiter>
+    std::vector<unsigned char> imageOf(Arbiter& arbiter)
+    {
+        std::vector<unsigned char> image(arbiter.snapshotSize());
+        arbiter.snapshot(image.data());
+
+        std::fill(image.begin() + 8, image.begin() + 16, 0);
+        return image;
+    }
+
+    TEST(verifySnapshotOverwrittenWhileBeingReadLeavesTheStandbyAsItWas)
+    {
+        MockErrorReportingPolicy primaryPolicy;
+        MockErrorReportingPolicy standbyPolicy;
+        arbiter::SequenceArbiter<SnapshotRaceTraits> primary(primaryPolicy);
+        arbiter::SequenceArbiter<SnapshotRaceTraits> standby(standbyPolicy);
+
+        // the standby starts from a checkpoint with head well into the history.
+        std::size_t next = 0;
+        for(; next < 100; ++next)
+        {
+            CHECK(primary.validate(0, next));
+        }
+
+        std::vector<unsigned char> buffer(primary.snapshotSize());
+        primary.snapshot(buffer.data());
+        standby.restore(buffer.data());
+
+        std::atomic<bool> overwritten(false);
+        std::atomic<bool> done(false);
+
+        // checkpoints a quarter of the history apart, back to back.
+        std::thread writer([&primary, &buffer, &overwritten, &done, next]
+        {
+            for(std::size_t sequence = next; !overwritten.load() && (sequence < (std::size_t(1) << 26)); ++sequence)
+            {
+                primary.validate(0, sequence);
+                if((sequence % 1024) == 0)
+                {
+                    primary.snapshot(buffer.data());
+                }
+            }
+
+            done.store(true);
+        });
+
+        bool unchanged = true;
+
+        while(!overwritten.load() && !done.load())
+        {
+            const auto before = imageOf(standby);
+
+            try
+            {
+                standby.restore(buffer.data());
+            }
+            catch(const arbiter::InvalidSnapshot& e)
+            {
+                overwritten.store(std::string(e.what()).find("overwritten") != std::string::npos);
+                unchanged = unchanged && (imageOf(standby) == before);
+            }
+        }
+
+        writer.join();
+
+        CHECK(overwritten.load());
+        CHECK(unchanged);
+    }
 }
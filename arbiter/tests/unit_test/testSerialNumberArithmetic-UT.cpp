@@ -0,0 +1,293 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/ConcurrentSequenceArbiter.hpp>
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/details/NullErrorReportingPolicy.hpp>
+#include <arbiter/details/SequenceArithmetic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+    template<typename SequenceType>
+    class RecordingErrorReportingPolicy : public arbiter::details::NullErrorReportingPolicy<SequenceType>
+    {
+    public:
+        struct Range { SequenceType start; SequenceType length; };
+
+        void FirstSequenceNumberOutOfSequence(const std::size_t, const SequenceType) { ++outOfSequence; }
+        void DuplicateOnLine(const std::size_t, const SequenceType) { ++duplicates; }
+        void Gap(const SequenceType start, const SequenceType length) { gaps.push_back(Range{start, length}); }
+        void GapFill(const SequenceType, const SequenceType length) { gapFills += length; }
+        void UnrecoverableGap(const SequenceType start, const SequenceType length = 1) { unrecoverable.push_back(Range{start, length}); }
+
+        std::size_t outOfSequence = 0;
+        std::size_t duplicates = 0;
+        std::size_t gapFills = 0;
+
+        std::vector<Range> gaps;
+        std::vector<Range> unrecoverable;
+    };
+
+    template<typename Sequence, Sequence First>
+    struct SerialTraits
+    {
+        static constexpr Sequence FirstExpectedSequenceNumber() { return First; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+        static constexpr bool SerialNumberArithmetic() { return true; }
+
+        using SequenceType = Sequence;
+        using ErrorReportingPolicy = RecordingErrorReportingPolicy<Sequence>;
+    };
+
+    constexpr std::uint16_t Max16 = std::numeric_limits<std::uint16_t>::max();
+
+    struct PlainTraits16
+    {
+        using SequenceType = std::uint16_t;
+    };
+
+    using Traits16 = SerialTraits<std::uint16_t, Max16 - 3>;    // first expected 65532
+    using Policy16 = Traits16::ErrorReportingPolicy;
+    using Arbiter16 = arbiter::SequenceArbiter<Traits16>;
+
+    // feed line 0 from the first expected sequence number up to 65535.
+    void feedToWrap(Arbiter16& arbiter)
+    {
+        for(std::uint16_t sequence = Traits16::FirstExpectedSequenceNumber(); sequence != 0; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+    }
+
+    TEST(verifySequenceArithmeticOrdersAcrossTheWrap)
+    {
+        using Serial = arbiter::details::SequenceArithmetic<Traits16>;
+
+        CHECK_EQUAL(0, Serial::next(Max16));
+        CHECK_EQUAL(3, Serial::distance(Max16 - 1, 1));
+        CHECK(Serial::precedes(Max16, 0));
+        CHECK(Serial::precedesOrEqual(Max16 - 10, 20));
+        CHECK(!Serial::precedes(0, Max16));
+        CHECK(!Serial::precedesOrEqual(0, 0x8000));    // exactly half the range is ahead
+        CHECK(Serial::precedesOrEqual(7, 7));
+        CHECK(!Serial::precedes(7, 7));
+    }
+
+    TEST(verifySequenceArithmeticIsPlainByDefault)
+    {
+        using Plain = arbiter::details::SequenceArithmetic<PlainTraits16>;
+
+        CHECK(!Plain::precedes(Max16, 0));
+        CHECK(Plain::precedes(0, Max16));
+        CHECK_EQUAL(0, Plain::next(Max16));
+    }
+
+    TEST(verifySerialArbiterAdvancesHeadAndLineAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        Arbiter16 arbiter(errorPolicy);
+
+        feedToWrap(arbiter);
+        CHECK(arbiter.validate(0, 0));
+        CHECK(arbiter.validate(0, 1));
+
+        // line 1 follows through the wrap, AdvanceLine
+        for(std::uint16_t sequence = Traits16::FirstExpectedSequenceNumber(); sequence != 2; ++sequence)
+        {
+            CHECK(!arbiter.validate(1, sequence));
+        }
+
+        // line 1 overtakes head across the wrap
+        CHECK(arbiter.validate(1, 2));
+
+        CHECK_EQUAL(0U, errorPolicy.duplicates);
+        CHECK_EQUAL(0U, errorPolicy.gaps.size());
+    }
+
+    TEST(verifySerialArbiterHeadForwardGapFillsAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        Arbiter16 arbiter(errorPolicy);
+
+        CHECK(arbiter.validate(0, Max16 - 3));
+        CHECK(arbiter.validate(0, Max16 - 2));
+        CHECK(arbiter.validate(0, 1));          // 65534, 65535, 0 missing
+
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.gaps.size());
+        CHECK_EQUAL(Max16 - 1, errorPolicy.gaps[0].start);
+        CHECK_EQUAL(3, errorPolicy.gaps[0].length);
+
+        // GapFill on line 0 and LineForwardGapFill on line 1 fill it
+        CHECK(arbiter.validate(0, Max16));
+        CHECK(!arbiter.validate(0, Max16));     // duplicate on line 0
+
+        CHECK(!arbiter.validate(1, Max16 - 3));
+        CHECK(arbiter.validate(1, Max16 - 1));  // forward across one slot
+        CHECK(arbiter.validate(1, 0));          // forward across the wrap
+
+        CHECK(!arbiter.validate(1, 1));
+        CHECK(arbiter.validate(1, 2));
+
+        CHECK_EQUAL(3U, errorPolicy.gapFills);
+        CHECK_EQUAL(1U, errorPolicy.duplicates);
+        CHECK_EQUAL(0U, errorPolicy.unrecoverable.size());
+    }
+
+    TEST(verifySerialArbiterReportsUnrecoverableGapsAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        Arbiter16 arbiter(errorPolicy);
+
+        feedToWrap(arbiter);
+        CHECK(arbiter.validate(0, 9));          // 0 to 8 missing, 5 recoverable
+
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.unrecoverable.size());
+        CHECK_EQUAL(0, errorPolicy.unrecoverable[0].start);
+        CHECK_EQUAL(4, errorPolicy.unrecoverable[0].length);
+
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.gaps.size());
+        CHECK_EQUAL(4, errorPolicy.gaps[0].start);
+        CHECK_EQUAL(5, errorPolicy.gaps[0].length);
+
+        CHECK(arbiter.validate(0, 4));          // GapFill of the recoverable part
+        CHECK(!arbiter.validate(1, Max16));     // delivered before the gap
+    }
+
+    TEST(verifySerialArbiterHandlesAnInitialGapAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        Arbiter16 arbiter(errorPolicy);
+
+        CHECK(!arbiter.validate(0, Max16 - 10));    // precedes the first expected sequence number
+        CHECK_EQUAL(1U, errorPolicy.outOfSequence);
+
+        CHECK(arbiter.validate(0, 1));              // 65532 to 0 missing
+
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.gaps.size());
+        CHECK_EQUAL(Max16 - 3, errorPolicy.gaps[0].start);
+        CHECK_EQUAL(5, errorPolicy.gaps[0].length);
+
+        CHECK(arbiter.validate(1, Max16 - 3));
+        CHECK(arbiter.validate(1, 0));
+        CHECK(!arbiter.validate(1, 1));
+    }
+
+    TEST(verifySerialArbiterValidatesBatchesAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        Arbiter16 arbiter(errorPolicy);
+
+        const std::uint16_t sequences[] = {Max16 - 3, Max16 - 2, Max16 - 1, Max16, 0, 1, 2};
+        bool accept[7];
+
+        CHECK_EQUAL(7U, arbiter.validateBatch(0, sequences, 7, accept));
+        CHECK_EQUAL(0U, arbiter.validateBatch(1, sequences, 7, accept));
+
+        CHECK_EQUAL(0U, errorPolicy.gaps.size());
+        CHECK_EQUAL(0U, errorPolicy.duplicates);
+    }
+
+    TEST(verifySerialArbiterValidatesRangesAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        Arbiter16 arbiter(errorPolicy);
+        arbiter::AcceptedIntervals<std::uint16_t, 2> intervals;
+
+        CHECK_EQUAL(7U, arbiter.validateRange(0, Max16 - 3, 7, intervals));
+
+        // line 1 follows across the wrap and overtakes line 0 with 3.
+        CHECK_EQUAL(1U, arbiter.validateRange(1, Max16 - 3, 8, intervals));
+        REQUIRE CHECK_EQUAL(1U, intervals.size());
+        CHECK_EQUAL(3, intervals[0].first);
+        CHECK_EQUAL(1U, intervals[0].count);
+
+        CHECK_EQUAL(0U, errorPolicy.gaps.size());
+        CHECK_EQUAL(0U, errorPolicy.duplicates);
+    }
+
+    TEST(verifySerialArbiterWrapsThirtyTwoBitSequences)
+    {
+        using Traits32 = SerialTraits<std::uint32_t, 0xFFFFFFF0U>;
+
+        Traits32::ErrorReportingPolicy errorPolicy;
+        arbiter::SequenceArbiter<Traits32> arbiter(errorPolicy);
+
+        std::uint32_t sequence = Traits32::FirstExpectedSequenceNumber();
+        for(std::size_t i = 0; i < 100; ++i, ++sequence)
+        {
+            CHECK(arbiter.validate(i % 2, sequence));
+            CHECK(!arbiter.validate((i + 1) % 2, sequence));
+        }
+
+        CHECK_EQUAL(0U, errorPolicy.gaps.size());
+        CHECK_EQUAL(0U, errorPolicy.duplicates);
+        CHECK_EQUAL(0U, errorPolicy.outOfSequence);
+    }
+
+    TEST(verifyConcurrentArbiterWrapsThirtyTwoBitSequences)
+    {
+        using Traits32 = SerialTraits<std::uint32_t, 4294967290U>;
+
+        Traits32::ErrorReportingPolicy errorPolicy;
+        arbiter::ConcurrentSequenceArbiter<Traits32> arbiter(errorPolicy);
+
+        std::uint32_t sequence = Traits32::FirstExpectedSequenceNumber();
+        for(std::size_t i = 0; i < 20; ++i, ++sequence)
+        {
+            CHECK(arbiter.validate(i % 2, sequence));
+            CHECK(!arbiter.validate((i + 1) % 2, sequence));
+        }
+
+        CHECK_EQUAL(0U, errorPolicy.gaps.size());
+        CHECK_EQUAL(0U, errorPolicy.unrecoverable.size());
+        CHECK_EQUAL(0U, errorPolicy.duplicates);
+        CHECK_EQUAL(0U, errorPolicy.outOfSequence);
+    }
+
+    TEST(verifyConcurrentArbiterReportsGapsAcrossTheWrap)
+    {
+        Policy16 errorPolicy;
+        arbiter::ConcurrentSequenceArbiter<Traits16> arbiter(errorPolicy);
+
+        CHECK(!arbiter.validate(0, Max16 - 10));    // precedes the first expected sequence number
+        CHECK_EQUAL(1U, errorPolicy.outOfSequence);
+
+        CHECK(arbiter.validate(0, Max16 - 3));
+        CHECK(arbiter.validate(0, Max16 - 2));
+        CHECK(arbiter.validate(0, 1));              // 65534, 65535, 0 missing
+
+        REQUIRE CHECK_EQUAL(1U, errorPolicy.gaps.size());
+        CHECK_EQUAL(Max16 - 1, errorPolicy.gaps[0].start);
+        CHECK_EQUAL(3, errorPolicy.gaps[0].length);
+
+        CHECK(arbiter.validate(1, Max16));          // fills across the wrap
+        CHECK(!arbiter.validate(1, Max16));         // duplicate on line 1
+        CHECK(!arbiter.validate(1, 1));
+        CHECK(arbiter.validate(1, 0));
+
+        CHECK_EQUAL(2U, errorPolicy.gapFills);
+        CHECK_EQUAL(1U, errorPolicy.duplicates);
+
+        // 2 to 19 missing, 5 recoverable. 65534 is lost as its slot is reused.
+        CHECK(arbiter.validate(0, 20));
+
+        REQUIRE CHECK_EQUAL(2U, errorPolicy.unrecoverable.size());
+        CHECK_EQUAL(2, errorPolicy.unrecoverable[0].start);
+        CHECK_EQUAL(13, errorPolicy.unrecoverable[0].length);
+        CHECK_EQUAL(Max16 - 1, errorPolicy.unrecoverable[1].start);
+        CHECK_EQUAL(1, errorPolicy.unrecoverable[1].length);
+
+        REQUIRE CHECK_EQUAL(2U, errorPolicy.gaps.size());
+        CHECK_EQUAL(15, errorPolicy.gaps[1].start);
+        CHECK_EQUAL(5, errorPolicy.gaps[1].length);
+
+        CHECK(!arbiter.validate(1, 3));             // unrecoverable, discarded
+        CHECK(arbiter.validate(1, 15));
+        CHECK(!arbiter.validate(1, Max16 - 3));     // left the history
+    }
+}
@@ -0,0 +1,75 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/Exceptions.hpp>
+#include <arbiter/details/SpscRing.hpp>
+
+#include <cstddef>
+#include <thread>
+
+namespace {
+
+    TEST(verifySpscRingIsFirstInFirstOutAndBounded)
+    {
+        arbiter::details::SpscRing<int> ring(4);
+        CHECK_EQUAL(4U, ring.capacity());
+        CHECK(ring.front() == nullptr);
+
+        for(int i = 0; i < 4; ++i)
+        {
+            CHECK(ring.tryPush(i));
+        }
+
+        CHECK(!ring.tryPush(4));
+
+        REQUIRE CHECK(ring.front() != nullptr);
+        CHECK_EQUAL(0, *ring.front());
+        ring.pop();
+
+        CHECK(ring.tryPush(4));     // wraps
+
+        for(int i = 1; i <= 4; ++i)
+        {
+            REQUIRE CHECK(ring.front() != nullptr);
+            CHECK_EQUAL(i, *ring.front());
+            ring.pop();
+        }
+
+        CHECK(ring.front() == nullptr);
+    }
+
+    TEST(verifySpscRingRejectsCapacitiesWhichArentPowersOfTwo)
+    {
+        CHECK_THROW(arbiter::details::SpscRing<int>(0), arbiter::InvalidRingCapacity);
+        CHECK_THROW(arbiter::details::SpscRing<int>(12), arbiter::InvalidRingCapacity);
+    }
+
+    TEST(verifySpscRingPassesValuesBetweenThreadsInOrder)
+    {
+        constexpr std::size_t Values = 100000;
+        arbiter::details::SpscRing<std::size_t> ring(64);
+
+        std::thread producer([&ring]
+        {
+            for(std::size_t i = 0; i < Values; ++i)
+            {
+                while(!ring.tryPush(i))
+                {
+                }
+            }
+        });
+
+        std::size_t outOfOrder = 0;
+        for(std::size_t expected = 0; expected < Values; ++expected)
+        {
+            const std::size_t* value = nullptr;
+            while((value = ring.front()) == nullptr)
+            {
+            }
+
+            outOfOrder += (*value == expected) ? 0 : 1;
+            ring.pop();
+        }
+
+        producer.join();
+        CHECK_EQUAL(0U, outOfOrder);
+    }
+}
@@ -0,0 +1,141 @@
+#include "./platform/UnitTestSupport.hpp"
+#include <arbiter/SequenceArbiter.hpp>
+#include <arbiter/StatsErrorReportingPolicy.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+    using StatsPolicy = arbiter::StatsErrorReportingPolicy<std::size_t, 2>;
+
+    struct StatsTraits
+    {
+        static constexpr std::size_t FirstExpectedSequenceNumber() { return 1; }
+        static constexpr std::size_t LargestRecoverableGap() { return 5; }
+        static constexpr std::size_t NumberOfLines() { return 2; }
+        static constexpr std::size_t HistoryDepth() { return 10; }
+
+        using SequenceType = std::size_t;
+        using ErrorReportingPolicy = StatsPolicy;
+    };
+
+    std::uint64_t total(const StatsPolicy::Histogram& histogram)
+    {
+        std::uint64_t sum = 0;
+        for(auto count : histogram)
+        {
+            sum += count;
+        }
+
+        return sum;
+    }
+
+    TEST(verifyStatsErrorReportingPolicyBucketsByPowerOfTwo)
+    {
+        CHECK_EQUAL(0U, StatsPolicy::bucket(0));
+        CHECK_EQUAL(1U, StatsPolicy::bucket(1));
+        CHECK_EQUAL(2U, StatsPolicy::bucket(2));
+        CHECK_EQUAL(2U, StatsPolicy::bucket(3));
+        CHECK_EQUAL(3U, StatsPolicy::bucket(4));
+        CHECK_EQUAL(64U, StatsPolicy::bucket(~0ULL));
+    }
+
+    TEST(verifyStatsErrorReportingPolicyCountsArbiterEvents)
+    {
+        StatsPolicy stats;
+        arbiter::SequenceArbiter<StatsTraits> arbiter(stats);
+
+        CHECK(!arbiter.validate(1, 0));     // before the first expected sequence number
+        CHECK(arbiter.validate(0, 1));
+        CHECK(arbiter.validate(0, 4));      // gap of 2
+        CHECK(!arbiter.validate(1, 1));
+        CHECK(arbiter.validate(1, 2));      // filled while head is 2 ahead
+        CHECK(!arbiter.validate(1, 2));     // duplicate on line 1
+        CHECK(arbiter.validate(0, 3));      // filled while head is 1 ahead
+
+        auto snapshot = stats.snapshot();
+
+        CHECK_EQUAL(1U, snapshot.lines[1].firstSequenceNumberOutOfSequence);
+        CHECK_EQUAL(0U, snapshot.lines[0].duplicates);
+        CHECK_EQUAL(1U, snapshot.lines[1].duplicates);
+
+        CHECK_EQUAL(1U, snapshot.gaps);
+        CHECK_EQUAL(2U, snapshot.gapMessages);
+        CHECK_EQUAL(1U, snapshot.gapLength[2]);
+
+        CHECK_EQUAL(2U, snapshot.gapFills);
+        CHECK_EQUAL(1U, snapshot.gapFillLatency[1]);
+        CHECK_EQUAL(1U, snapshot.gapFillLatency[2]);
+        CHECK_EQUAL(2U, total(snapshot.gapFillLatency));
+
+        CHECK(arbiter.validate(0, 100));    // 90 unrecoverable, then a gap of 5
+        snapshot = stats.snapshot();
+
+        CHECK_EQUAL(1U, snapshot.unrecoverableGaps);
+        CHECK_EQUAL(90U, snapshot.unrecoverableGapMessages);
+        CHECK_EQUAL(2U, snapshot.gaps);
+        CHECK_EQUAL(7U, snapshot.gapMessages);
+        CHECK_EQUAL(1U, snapshot.gapLength[3]);
+    }
+
+    TEST(verifyStatsErrorReportingPolicyCountsLineGapsAndOverruns)
+    {
+        StatsPolicy stats;
+        arbiter::SequenceArbiter<StatsTraits> arbiter(stats);
+
+        // line 1 never reports, once history wraps every sequence overruns line 1 and is a line gap on it.
+        for(std::size_t sequence = 1; sequence <= 20; ++sequence)
+        {
+            CHECK(arbiter.validate(0, sequence));
+        }
+
+        const auto snapshot = stats.snapshot();
+        CHECK_EQUAL(10U, snapshot.lines[1].unrecoverableLineGaps);
+        CHECK_EQUAL(0U, snapshot.lines[0].unrecoverableLineGaps);
+        CHECK_EQUAL(10U, snapshot.lines[1].overruns);
+        CHECK_EQUAL(0U, snapshot.lines[0].overruns);
+    }
+
+    TEST(verifyStatsErrorReportingPolicySnapshotsAreConsistent)
+    {
+        StatsPolicy stats;
+        std::atomic<bool> done(false);
+
+        std::thread feed([&stats, &done]
+        {
+            for(std::size_t i = 0; i < 200000; ++i)
+            {
+                stats.Gap(i, 3);
+                stats.DuplicateOnLine(i % 2, i);
+            }
+
+            done.store(true);
+        });
+
+        std::uint64_t lastGaps = 0;
+        bool consistent = true;
+
+        while(!done.load())
+        {
+            const auto snapshot = stats.snapshot();
+
+            // each Gap() updates all three at once.
+            consistent = consistent && (snapshot.gapMessages == 3 * snapshot.gaps);
+            consistent = consistent && (snapshot.gapLength[2] == snapshot.gaps);
+            consistent = consistent && (snapshot.gaps >= lastGaps);
+
+            lastGaps = snapshot.gaps;
+        }
+
+        feed.join();
+        CHECK(consistent);
+
+        const auto snapshot = stats.snapshot();
+        CHECK_EQUAL(200000U, snapshot.gaps);
+        CHECK_EQUAL(100000U, snapshot.lines[0].duplicates);
+        CHECK_EQUAL(100000U, snapshot.lines[1].duplicates);
+    }
+}